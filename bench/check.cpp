@@ -0,0 +1,230 @@
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include <unordered_set>
+
+#include "artic/log.h"
+#include "artic/bind.h"
+#include "artic/check.h"
+#include "artic/parser.h"
+#include "artic/source.h"
+
+using namespace artic;
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsed_ms(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/// Collects the given node and the nodes of the most common expressions and declarations below it.
+static void collect_nodes(const ast::Node* node, std::vector<const ast::Node*>& nodes) {
+    if (!node)
+        return;
+    nodes.push_back(node);
+    if (auto mod_decl = node->isa<ast::ModDecl>()) {
+        for (auto& decl : mod_decl->decls)
+            collect_nodes(decl.get(), nodes);
+    } else if (auto fn_decl = node->isa<ast::FnDecl>()) {
+        collect_nodes(fn_decl->fn.get(), nodes);
+    } else if (auto fn_expr = node->isa<ast::FnExpr>()) {
+        collect_nodes(fn_expr->body.get(), nodes);
+    } else if (auto static_decl = node->isa<ast::StaticDecl>()) {
+        collect_nodes(static_decl->init.get(), nodes);
+    } else if (auto let_decl = node->isa<ast::LetDecl>()) {
+        collect_nodes(let_decl->init.get(), nodes);
+    } else if (auto block_expr = node->isa<ast::BlockExpr>()) {
+        for (auto& stmt : block_expr->stmts)
+            collect_nodes(stmt.get(), nodes);
+    } else if (auto decl_stmt = node->isa<ast::DeclStmt>()) {
+        collect_nodes(decl_stmt->decl.get(), nodes);
+    } else if (auto expr_stmt = node->isa<ast::ExprStmt>()) {
+        collect_nodes(expr_stmt->expr.get(), nodes);
+    } else if (auto call_expr = node->isa<ast::CallExpr>()) {
+        collect_nodes(call_expr->callee.get(), nodes);
+        collect_nodes(call_expr->arg.get(), nodes);
+    } else if (auto tuple_expr = node->isa<ast::TupleExpr>()) {
+        for (auto& arg : tuple_expr->args)
+            collect_nodes(arg.get(), nodes);
+    } else if (auto array_expr = node->isa<ast::ArrayExpr>()) {
+        for (auto& elem : array_expr->elems)
+            collect_nodes(elem.get(), nodes);
+    } else if (auto if_expr = node->isa<ast::IfExpr>()) {
+        collect_nodes(if_expr->cond.get(), nodes);
+        collect_nodes(if_expr->expr.get(), nodes);
+        collect_nodes(if_expr->if_true.get(), nodes);
+        collect_nodes(if_expr->if_false.get(), nodes);
+    } else if (auto while_expr = node->isa<ast::WhileExpr>()) {
+        collect_nodes(while_expr->cond.get(), nodes);
+        collect_nodes(while_expr->expr.get(), nodes);
+        collect_nodes(while_expr->body.get(), nodes);
+    } else if (auto match_expr = node->isa<ast::MatchExpr>()) {
+        collect_nodes(match_expr->arg.get(), nodes);
+        for (auto& case_ : match_expr->cases)
+            collect_nodes(case_->expr.get(), nodes);
+    } else if (auto unary_expr = node->isa<ast::UnaryExpr>()) {
+        collect_nodes(unary_expr->arg.get(), nodes);
+    } else if (auto binary_expr = node->isa<ast::BinaryExpr>()) {
+        collect_nodes(binary_expr->left.get(), nodes);
+        collect_nodes(binary_expr->right.get(), nodes);
+    } else if (auto typed_expr = node->isa<ast::TypedExpr>()) {
+        collect_nodes(typed_expr->expr.get(), nodes);
+    } else if (auto cast_expr = node->isa<ast::CastExpr>()) {
+        collect_nodes(cast_expr->expr.get(), nodes);
+    } else if (auto proj_expr = node->isa<ast::ProjExpr>()) {
+        collect_nodes(proj_expr->expr.get(), nodes);
+    }
+}
+
+/// Measures the time spent in `dynamic_cast` and in `isa` to test the same objects against `T`,
+/// and reports both timings side by side.
+template <typename T, typename U>
+static void bench_cast(const char* name, const std::vector<const U*>& objs, size_t iters) {
+    size_t rtti_matches = 0, tag_matches = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < iters; ++i) {
+        for (auto obj : objs)
+            rtti_matches += dynamic_cast<const T*>(obj) ? 1 : 0;
+    }
+    auto rtti = elapsed_ms(start);
+    start = Clock::now();
+    for (size_t i = 0; i < iters; ++i) {
+        for (auto obj : objs)
+            tag_matches += isa<const T*>(obj) ? 1 : 0;
+    }
+    auto tags = elapsed_ms(start);
+
+    auto queries = double(iters * objs.size());
+    log::out << "isa<" << name << ">: " << tags * 1.0e6 / queries << " ns, dynamic_cast: "
+             << rtti * 1.0e6 / queries << " ns per query (" << tag_matches / iters << " of " << objs.size() << " objects)";
+    if (rtti_matches != tag_matches)
+        log::out << " mismatch with dynamic_cast (" << rtti_matches / iters << " objects)";
+    log::out << "\n";
+}
+
+/// Compares the tag-based `isa` with `dynamic_cast`, on the nodes of the given program and on their types.
+/// Leaf classes and classes covering a range of kinds are both measured.
+static void bench_casts(const ast::ModDecl& program, size_t iters) {
+    std::vector<const ast::Node*> nodes;
+    collect_nodes(&program, nodes);
+    std::unordered_set<const Type*> type_set;
+    for (auto node : nodes) {
+        if (node->type)
+            type_set.insert(node->type);
+    }
+    std::vector<const Type*> types(type_set.begin(), type_set.end());
+
+    bench_cast<ast::Expr>("ast::Expr", nodes, iters);
+    bench_cast<ast::Decl>("ast::Decl", nodes, iters);
+    bench_cast<ast::CallExpr>("ast::CallExpr", nodes, iters);
+    bench_cast<ast::LiteralExpr>("ast::LiteralExpr", nodes, iters);
+    bench_cast<TupleType>("TupleType", types, iters);
+    bench_cast<AddrType>("AddrType", types, iters);
+    bench_cast<PtrType>("PtrType", types, iters);
+    bench_cast<FnType>("FnType", types, iters);
+}
+
+/// Measures the time spent in name binding and type checking for the given files.
+/// Parsing is done on every iteration, but is not part of the measurement.
+static bool bench_checker(const std::vector<std::string>& files, size_t iters) {
+    std::vector<SourceFile> sources;
+    for (auto& file : files) {
+        auto source = SourceFile::open(file);
+        if (!source) {
+            log::error("cannot open file '{}'", file);
+            return false;
+        }
+        sources.emplace_back(std::move(*source));
+    }
+
+    double total = 0;
+    for (size_t i = 0; i < iters; ++i) {
+        Log log(log::err);
+        Arena arena;
+        TypeTable type_table;
+        auto program = arena.make_ptr<ast::ModDecl>(arena);
+        for (size_t j = 0; j < files.size(); ++j) {
+            Lexer lexer(log, files[j], sources[j].data(), arena);
+            Parser parser(log, lexer, arena);
+            auto module = parser.parse();
+            for (auto& decl : module->decls)
+                program->decls.push_back(std::move(decl));
+        }
+        if (log.errors > 0)
+            return false;
+        program->set_super();
+
+        auto start = Clock::now();
+        NameBinder name_binder(log);
+        TypeChecker type_checker(log, type_table, arena);
+        if (!name_binder.run(*program) || !type_checker.run(*program))
+            return false;
+        total += elapsed_ms(start);
+
+        // The casts are measured on the last program, once it has been type checked
+        if (i == iters - 1) {
+            log::out << "checker: " << total / iters << " ms per iteration\n";
+            bench_casts(*program, iters);
+        }
+    }
+    return true;
+}
+
+/// Measures the time spent in subtyping queries between structural types.
+/// A new type table is created on every iteration, so that queries are not cached.
+static void bench_subtype(size_t iters) {
+    static constexpr ast::PrimType::Tag tags[] = {
+        ast::PrimType::Bool, ast::PrimType::I32, ast::PrimType::I64, ast::PrimType::F32, ast::PrimType::F64
+    };
+
+    double total = 0;
+    size_t queries = 0, subtypes = 0;
+    for (size_t i = 0; i < iters; ++i) {
+        TypeTable type_table;
+        std::vector<const Type*> types;
+        for (auto tag : tags) {
+            auto prim = type_table.prim_type(tag);
+            auto ptr  = type_table.ptr_type(prim, false, 0);
+            auto ref  = type_table.ref_type(prim, true, 0);
+            auto arr  = type_table.unsized_array_type(prim);
+            types.push_back(prim);
+            types.push_back(ptr);
+            types.push_back(ref);
+            types.push_back(type_table.ptr_type(arr, false, 0));
+            types.push_back(type_table.ptr_type(type_table.sized_array_type(prim, 4, false), false, 0));
+            types.push_back(type_table.tuple_type(std::array<const Type*, 2> { prim, ptr }));
+            types.push_back(type_table.fn_type(ptr, prim));
+            types.push_back(type_table.fn_type(type_table.tuple_type(std::array<const Type*, 2> { prim, ref }), type_table.no_ret_type()));
+        }
+        types.push_back(type_table.bottom_type());
+        types.push_back(type_table.top_type());
+        types.push_back(type_table.no_ret_type());
+
+        auto start = Clock::now();
+        for (auto a : types) {
+            for (auto b : types)
+                subtypes += a->subtype(b) ? 1 : 0;
+        }
+        total += elapsed_ms(start);
+        queries += types.size() * types.size();
+    }
+    log::out << "subtype: " << total * 1.0e6 / queries << " ns per query (" << subtypes << " subtypes)\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        log::out << "usage: artic-bench-check iterations [files...]\n";
+        return EXIT_FAILURE;
+    }
+    auto iters = std::strtoul(argv[1], nullptr, 10);
+    if (iters == 0)
+        iters = 1;
+
+    bench_subtype(iters);
+    std::vector<std::string> files(argv + 2, argv + argc);
+    if (!files.empty() && !bench_checker(files, iters))
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
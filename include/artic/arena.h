@@ -5,6 +5,8 @@
 #include <memory>
 #include <vector>
 #include <tuple>
+#include <iterator>
+#include <cassert>
 
 template<typename T>
 /** works like unique_ptr but doesn't actually own anything */
@@ -21,9 +23,6 @@ struct arena_ptr {
     arena_ptr(arena_ptr<S>&& other) : _ptr(other._ptr) {
         other._ptr = nullptr;
     }
-    ~arena_ptr() {
-        _ptr = nullptr;
-    }
 
     // arena_ptr<T>& operator=(const arena_ptr<T>& other) { _ptr = other._ptr; return *this; }
     arena_ptr<T>& operator=(arena_ptr<T>&& other) { _ptr = other._ptr; other._ptr = nullptr; return *this; }
@@ -42,19 +41,49 @@ struct arena_ptr {
 };
 
 struct Arena {
+    /// Allocation statistics, in bytes unless specified otherwise.
+    /// Except for the blocks, these are not decreased when the arena is rewound.
+    struct Stats {
+        size_t num_blocks = 0;  ///< Number of blocks allocated so far.
+        size_t num_large  = 0;  ///< Number of objects allocated outside of blocks.
+        size_t reserved   = 0;  ///< Total size of the blocks.
+        size_t used       = 0;  ///< Total size of the objects allocated in blocks.
+        size_t large      = 0;  ///< Total size of the objects allocated outside of blocks.
+        size_t wasted     = 0;  ///< Alignment padding and unused space at the end of full blocks.
+    };
+
+    /// Position in the arena, used to free every object allocated after it.
+    struct Mark {
+        size_t block;
+        size_t available;
+        size_t large;
+        size_t cleanup;
+    };
+
     Arena();
     ~Arena();
 
+    Arena(const Arena&) = delete;
+    Arena& operator = (const Arena&) = delete;
+
+    /// Returns the current position in the arena.
+    Mark mark() const { return Mark { _cur, _available, _large.size(), _cleanup.size() }; }
+    /// Destroys every object allocated since the given mark was taken.
+    /// The memory of the blocks is kept, and reused by the next allocations.
+    void rewind(const Mark&);
+    /// Destroys every object in the arena, but keeps the blocks for subsequent allocations.
+    void reset();
+
     template<typename T, typename std::enable_if<std::is_trivially_destructible<T>::value, bool>::type = true, typename ...Args>
     arena_ptr<T> make_ptr(Args&& ...args) {
-        void* ptr = alloc(sizeof(T));
+        void* ptr = alloc(sizeof(T), alignof(T));
         new (ptr) T (std::forward<Args>(args)...);
         return arena_ptr<T>(static_cast<T*>(ptr));
     }
 
     template<typename T, typename std::enable_if<!std::is_trivially_destructible<T>::value, bool>::type = true, typename ...Args>
     arena_ptr<T> make_ptr(Args&& ...args) {
-        void* ptr = alloc(sizeof(T));
+        void* ptr = alloc(sizeof(T), alignof(T));
         new (ptr) T (std::forward<Args>(args)...);
         auto deleter = [] (T* t) -> void {
             t->~T();
@@ -64,14 +93,101 @@ struct Arena {
         _cleanup.emplace_back(generic_fn, ptr);
         return arena_ptr<T>(static_cast<T*>(ptr));
     }
+
+    const Stats& stats() const { return _stats; }
+
 private:
-    void* alloc(size_t);
+    template <typename T> friend struct arena_vector;
+
+    static constexpr size_t min_block_size = 4096;
+    static constexpr size_t max_block_size = 1 << 20;
+
+    struct Block {
+        void* data;
+        size_t size;
+    };
+
+    void* alloc(size_t, size_t);
+    void* alloc_large(size_t, size_t);
     void grow();
 
-    size_t _block_size;
+    size_t _cur;
     size_t _available;
-    std::vector<void*> _data;
+    std::vector<Block> _blocks;
+    std::vector<void*> _large;
     std::vector<std::tuple<void (*)(void*), void*>> _cleanup;
+    Stats _stats;
+};
+
+template<typename T>
+/** growable array stored in an arena: like arena_ptr, it doesn't own its elements, which are never destroyed */
+struct arena_vector {
+    static_assert(std::is_trivially_destructible<T>::value, "elements of an arena_vector are never destroyed");
+
+    T* _data;
+    size_t _size;
+    size_t _capacity;
+    Arena* _arena;
+
+    arena_vector() : _data(nullptr), _size(0), _capacity(0), _arena(nullptr) {}
+    explicit arena_vector(Arena& arena) : _data(nullptr), _size(0), _capacity(0), _arena(&arena) {}
+
+    template<typename It>
+    arena_vector(Arena& arena, It begin, It end) : arena_vector(arena) {
+        reserve(std::distance(begin, end));
+        for (; begin != end; ++begin)
+            new (_data + _size++) T(*begin);
+    }
+
+    arena_vector(arena_vector<T>&& other)
+        : _data(other._data), _size(other._size), _capacity(other._capacity), _arena(other._arena)
+    {
+        other._data = nullptr;
+        other._size = other._capacity = 0;
+    }
+
+    arena_vector<T>& operator=(arena_vector<T>&& other) {
+        _data = other._data;
+        _size = other._size;
+        _capacity = other._capacity;
+        _arena = other._arena;
+        other._data = nullptr;
+        other._size = other._capacity = 0;
+        return *this;
+    }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    T* data() const { return _data; }
+    T* begin() const { return _data; }
+    T* end() const { return _data + _size; }
+
+    T& operator[](size_t i) const { assert(i < _size); return _data[i]; }
+    T& front() const { assert(_size > 0); return _data[0]; }
+    T& back() const { assert(_size > 0); return _data[_size - 1]; }
+
+    void reserve(size_t capacity) {
+        if (capacity <= _capacity)
+            return;
+        assert(_arena && "arena_vector created without an arena cannot grow");
+        // The previous storage is left in the arena, and reclaimed along with it
+        auto data = static_cast<T*>(_arena->alloc(sizeof(T) * capacity, alignof(T)));
+        for (size_t i = 0; i < _size; ++i)
+            new (data + i) T(std::move(_data[i]));
+        _data = data;
+        _capacity = capacity;
+    }
+
+    template<typename ...Args>
+    T& emplace_back(Args&& ...args) {
+        if (_size == _capacity)
+            reserve(_capacity ? _capacity * 2 : 4);
+        return *new (_data + _size++) T(std::forward<Args>(args)...);
+    }
+
+    void push_back(T&& t) { emplace_back(std::move(t)); }
+    void push_back(const T& t) { emplace_back(t); }
 };
 
 #endif // ARTIC_ARENA_H
@@ -27,22 +27,47 @@ class Emitter;
 class Summoner;
 
 template <typename T> using Ptr = arena_ptr<T>;
-template <typename T> using PtrVector = std::vector<Ptr<T>>;
+template <typename T> using PtrVector = arena_vector<Ptr<T>>;
 
 namespace ast {
 
 /// Identifier with its location in the file
 struct Identifier {
     Loc loc;
-    std::string name;
+    Name name;
 
     Identifier() {}
-    Identifier(const Loc& loc, std::string&& name)
-        : loc(loc), name(std::move(name))
-    {}
-};
-
-/// Base class for all AST nodes.
+    Identifier(const Loc& loc, Name name)
+        : loc(loc), name(name)
+    {}
+};
+
+/// Tag identifying the concrete class of an AST node. Kinds deriving from the same
+/// base class are contiguous, so that `classof` only needs a range check.
+enum class NodeKind : uint8_t {
+    Path, Filter, TypeParamList,
+    // Attributes
+    PathAttr, LiteralAttr, NamedAttr, AttrList,
+    // Types
+    PrimType, TupleType, SizedArrayType, UnsizedArrayType, FnType, PtrType, TypeApp, NoCodomType, ErrorType,
+    // Statements
+    DeclStmt, ExprStmt,
+    // Expressions
+    TypedExpr, PathExpr, LiteralExpr, SummonExpr, FieldExpr, RecordExpr, TupleExpr, ArrayExpr, RepeatArrayExpr,
+    FnExpr, BlockExpr, CallExpr, ProjExpr, IfExpr, CaseExpr, MatchExpr, WhileExpr, ForExpr, BreakExpr,
+    ContinueExpr, ReturnExpr, UnaryExpr, BinaryExpr, FilterExpr, CastExpr, ImplicitCastExpr, AsmExpr, ErrorExpr,
+    // Declarations (value, record, constructor, and named declarations first)
+    PtrnDecl, StaticDecl, FnDecl, StructDecl, OptionDecl, EnumDecl, TypeParam, FieldDecl, TypeDecl, ModDecl,
+    UseDecl, LetDecl, ImplicitDecl, ErrorDecl,
+    // Patterns
+    TypedPtrn, IdPtrn, LiteralPtrn, ImplicitParamPtrn, FieldPtrn, RecordPtrn, CtorPtrn, TuplePtrn, ArrayPtrn,
+    ErrorPtrn
+};
+
+/// Base class for all AST nodes. Nodes are allocated in an arena, and their
+/// contents are stored there as well, so that most of them are trivially
+/// destructible: they are then freed along with the arena, without being destroyed.
+/// For this reason, nodes must not be deleted through a pointer to this class.
 struct Node : public Cast<Node> {
     /// Location of the node in the source file.
     Loc loc;
@@ -55,14 +80,15 @@ struct Node : public Cast<Node> {
     /// List of attributes associated with the node.
     Ptr<struct AttrList> attrs;
 
-    Node(const Loc& loc)
-        : loc(loc)
+    /// Kind of the node, used by `isa` and `as` instead of RTTI.
+    NodeKind kind;
+
+    Node(NodeKind kind, const Loc& loc)
+        : loc(loc), kind(kind)
     {}
 
     Node(Node&&) = default;
 
-    virtual ~Node() {}
-
     /// Binds identifiers to AST nodes.
     virtual void bind(NameBinder&) = 0;
     /// Infers the type of the node.
@@ -86,26 +112,36 @@ log::Output& operator << (log::Output&, const Node&);
 
 /// Base class for all declarations.
 struct Decl : public Node {
-    Decl(const Loc& loc) : Node(loc) {}
+    Decl(NodeKind kind, const Loc& loc) : Node(kind, loc) {}
 
     /// Set to true if this declaration is at the top level of a module.
     bool is_top_level = false;
 
     /// Binds the declaration to its AST node, without entering sub-AST nodes.
     virtual void bind_head(NameBinder&) {}
+
+    using ClassOf = Decl;
+    static bool classof(const Node* node) {
+        return node->kind >= NodeKind::PtrnDecl && node->kind <= NodeKind::ErrorDecl;
+    }
 };
 
 /// Base class for types.
 struct Type : public Node {
-    Type(const Loc& loc) : Node(loc) {}
+    Type(NodeKind kind, const Loc& loc) : Node(kind, loc) {}
 
     bool is_tuple() const;
     void resolve_summons(Summoner&) override {};
+
+    using ClassOf = Type;
+    static bool classof(const Node* node) {
+        return node->kind >= NodeKind::PrimType && node->kind <= NodeKind::ErrorType;
+    }
 };
 
 /// Base class for statements.
 struct Stmt : public Node {
-    Stmt(const Loc& loc) : Node(loc) {}
+    Stmt(NodeKind kind, const Loc& loc) : Node(kind, loc) {}
 
     /// Returns true if the statement is changes the control-flow.
     virtual bool is_jumping() const = 0;
@@ -113,11 +149,16 @@ struct Stmt : public Node {
     virtual bool needs_semicolon() const = 0;
     /// Returns true if the statement has a side effect.
     virtual bool has_side_effect() const = 0;
+
+    using ClassOf = Stmt;
+    static bool classof(const Node* node) {
+        return node->kind >= NodeKind::DeclStmt && node->kind <= NodeKind::ExprStmt;
+    }
 };
 
 /// Base class for expressions.
 struct Expr : public Node {
-    Expr(const Loc& loc) : Node(loc) {}
+    Expr(NodeKind kind, const Loc& loc) : Node(kind, loc) {}
 
     bool is_tuple() const;
 
@@ -135,13 +176,18 @@ struct Expr : public Node {
     virtual bool has_side_effect() const { return false; }
     /// Returns true if the expression has a side effect.
     virtual bool is_constant() const { return false; }
+
+    using ClassOf = Expr;
+    static bool classof(const Node* node) {
+        return node->kind >= NodeKind::TypedExpr && node->kind <= NodeKind::ErrorExpr;
+    }
 };
 
 struct IdPtrn;
 
 /// Pattern: An expression which does not need evaluation.
 struct Ptrn : public Node {
-    Ptrn(const Loc& loc) : Node(loc) {}
+    Ptrn(NodeKind kind, const Loc& loc) : Node(kind, loc) {}
 
     Ptr<Expr> as_expr;
 
@@ -157,6 +203,11 @@ struct Ptrn : public Node {
     virtual bool is_trivial() const = 0;
     /// Emits IR for the pattern, given a value to bind it to.
     virtual void emit(Emitter&, const thorin::Def*) const;
+
+    using ClassOf = Ptrn;
+    static bool classof(const Node* node) {
+        return node->kind >= NodeKind::TypedPtrn && node->kind <= NodeKind::ErrorPtrn;
+    }
 };
 
 // Path ----------------------------------------------------------------------------
@@ -171,7 +222,7 @@ struct Path : public Node {
         // These members are set during type-checking
         const artic::Type* type = nullptr;
         size_t index = 0;
-        std::vector<const artic::Type*> inferred_args;
+        arena_vector<const artic::Type*> inferred_args;
 
         bool is_super() const { return id.name == "super"; }
 
@@ -180,7 +231,7 @@ struct Path : public Node {
         {}
     };
 
-    std::vector<Elem> elems;
+    arena_vector<Elem> elems;
 
     // Set during name-binding, corresponds to the declaration that
     // is associated with the _first_ element of the path.
@@ -191,8 +242,8 @@ struct Path : public Node {
     bool is_value = false;
     bool is_ctor = false;
 
-    Path(const Loc& loc, std::vector<Elem>&& elems)
-        : Node(loc), elems(std::move(elems))
+    Path(const Loc& loc, arena_vector<Elem>&& elems)
+        : Node(NodeKind::Path, loc), elems(std::move(elems))
     {}
 
     const artic::Type* infer(TypeChecker&, bool, Ptr<Expr>* = nullptr);
@@ -204,6 +255,9 @@ struct Path : public Node {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override {};
     void print(Printer&) const override;
+
+    using ClassOf = Path;
+    static bool classof(const Node* node) { return node->kind == NodeKind::Path; }
 };
 
 // Filter --------------------------------------------------------------------------
@@ -213,7 +267,7 @@ struct Filter : public Node {
     Ptr<Expr> expr;
 
     Filter(const Loc& loc, Ptr<Expr>&& expr)
-        : Node(loc), expr(std::move(expr))
+        : Node(NodeKind::Filter, loc), expr(std::move(expr))
     {}
 
     const thorin::Def* emit(Emitter&) const override;
@@ -221,16 +275,19 @@ struct Filter : public Node {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = Filter;
+    static bool classof(const Node* node) { return node->kind == NodeKind::Filter; }
 };
 
 // Attributes ----------------------------------------------------------------------
 
 /// Base class for all attributes.
 struct Attr : public Node {
-    std::string name;
+    Name name;
 
-    Attr(const Loc& loc, std::string&& name)
-        : Node(loc), name(std::move(name))
+    Attr(NodeKind kind, const Loc& loc, Name name)
+        : Node(kind, loc), name(name)
     {}
 
     /// Checks that the attribute is well-formed.
@@ -240,31 +297,42 @@ struct Attr : public Node {
 
     void resolve_summons(Summoner&) override {};
     void bind(NameBinder&) override;
+
+    using ClassOf = Attr;
+    static bool classof(const Node* node) {
+        return node->kind >= NodeKind::PathAttr && node->kind <= NodeKind::AttrList;
+    }
 };
 
 /// Attribute with an associated path.
 struct PathAttr : public Attr {
     Path path;
 
-    PathAttr(const Loc& loc, std::string&& name, Path&& path)
-        : Attr(loc, std::move(name)), path(std::move(path))
+    PathAttr(const Loc& loc, Name name, Path&& path)
+        : Attr(NodeKind::PathAttr, loc, name), path(std::move(path))
     {}
 
     void check(TypeChecker&, const ast::Node*) override;
     void bind(NameBinder&) override;
     void print(Printer&) const override;
+
+    using ClassOf = PathAttr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::PathAttr; }
 };
 
 /// Attribute with an associated literal.
 struct LiteralAttr : public Attr {
     Literal lit;
 
-    LiteralAttr(const Loc& loc, std::string&& name, const Literal& lit)
-        : Attr(loc, std::move(name)), lit(lit)
+    LiteralAttr(const Loc& loc, Name name, const Literal& lit)
+        : Attr(NodeKind::LiteralAttr, loc, name), lit(lit)
     {}
 
     void check(TypeChecker&, const ast::Node*) override;
     void print(Printer&) const override;
+
+    using ClassOf = LiteralAttr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::LiteralAttr; }
 };
 
 /// Attribute with only a name, optionally followed by a list of attribute
@@ -272,8 +340,8 @@ struct LiteralAttr : public Attr {
 struct NamedAttr : public Attr {
     PtrVector<Attr> args;
 
-    NamedAttr(const Loc& loc, std::string&& name, PtrVector<Attr>&& args)
-        : Attr(loc, std::move(name)), args(std::move(args))
+    NamedAttr(const Loc& loc, Name name, PtrVector<Attr>&& args)
+        : NamedAttr(NodeKind::NamedAttr, loc, name, std::move(args))
     {}
 
     const Attr* find(const std::string_view&) const override;
@@ -281,16 +349,29 @@ struct NamedAttr : public Attr {
     void check(TypeChecker&, const ast::Node*) override;
     void bind(NameBinder&) override;
     void print(Printer&) const override;
+
+    using ClassOf = NamedAttr;
+    static bool classof(const Node* node) {
+        return node->kind >= NodeKind::NamedAttr && node->kind <= NodeKind::AttrList;
+    }
+
+protected:
+    NamedAttr(NodeKind kind, const Loc& loc, Name name, PtrVector<Attr>&& args)
+        : Attr(kind, loc, name), args(std::move(args))
+    {}
 };
 
 /// Attribute list for statement blocks, or function declarations.
 struct AttrList : public NamedAttr {
     AttrList(const Loc& loc, PtrVector<Attr>&& attrs)
-        : NamedAttr(loc, "", std::move(attrs))
+        : NamedAttr(NodeKind::AttrList, loc, Name(), std::move(attrs))
     {}
 
     void check(TypeChecker&, const ast::Node*) override;
     void print(Printer&) const override;
+
+    using ClassOf = AttrList;
+    static bool classof(const Node* node) { return node->kind == NodeKind::AttrList; }
 };
 
 // Types ---------------------------------------------------------------------------
@@ -316,7 +397,7 @@ struct PrimType : public Type {
     Tag tag;
 
     PrimType(const Loc& loc, Tag tag)
-        : Type(loc), tag(tag)
+        : Type(NodeKind::PrimType, loc), tag(tag)
     {}
 
     const artic::Type* infer(TypeChecker&) override;
@@ -325,6 +406,9 @@ struct PrimType : public Type {
 
     static std::string tag_to_string(Tag tag);
     static Tag tag_from_token(const Token&);
+
+    using ClassOf = PrimType;
+    static bool classof(const Node* node) { return node->kind == NodeKind::PrimType; }
 };
 
 /// Tuple type, made of a product of simpler types.
@@ -332,23 +416,31 @@ struct TupleType : public Type {
     PtrVector<Type> args;
 
     TupleType(const Loc& loc, PtrVector<Type>&& args)
-        : Type(loc), args(std::move(args))
+        : Type(NodeKind::TupleType, loc), args(std::move(args))
     {}
 
     const artic::Type* infer(TypeChecker&) override;
     void bind(NameBinder&) override;
     void print(Printer&) const override;
+
+    using ClassOf = TupleType;
+    static bool classof(const Node* node) { return node->kind == NodeKind::TupleType; }
 };
 
 /// Base class for array types.
 struct ArrayType : public Type {
     Ptr<Type> elem;
 
-    ArrayType(const Loc& loc, Ptr<Type>&& elem)
-        : Type(loc), elem(std::move(elem))
+    ArrayType(NodeKind kind, const Loc& loc, Ptr<Type>&& elem)
+        : Type(kind, loc), elem(std::move(elem))
     {}
 
     void bind(NameBinder&) override;
+
+    using ClassOf = ArrayType;
+    static bool classof(const Node* node) {
+        return node->kind >= NodeKind::SizedArrayType && node->kind <= NodeKind::UnsizedArrayType;
+    }
 };
 
 /// Sized array type.
@@ -357,22 +449,28 @@ struct SizedArrayType : public ArrayType {
     bool is_simd;
 
     SizedArrayType(const Loc& loc, Ptr<Type>&& elem, std::variant<size_t, ast::Path>&& size, bool is_simd)
-        : ArrayType(loc, std::move(elem)), size(std::move(size)), is_simd(is_simd)
+        : ArrayType(NodeKind::SizedArrayType, loc, std::move(elem)), size(std::move(size)), is_simd(is_simd)
     {}
 
     const artic::Type* infer(TypeChecker&) override;
     void bind(NameBinder&) override;
     void print(Printer&) const override;
+
+    using ClassOf = SizedArrayType;
+    static bool classof(const Node* node) { return node->kind == NodeKind::SizedArrayType; }
 };
 
 /// Unsized array type.
 struct UnsizedArrayType : public ArrayType {
     UnsizedArrayType(const Loc& loc, Ptr<Type>&& elem)
-        : ArrayType(loc, std::move(elem))
+        : ArrayType(NodeKind::UnsizedArrayType, loc, std::move(elem))
     {}
 
     const artic::Type* infer(TypeChecker&) override;
     void print(Printer&) const override;
+
+    using ClassOf = UnsizedArrayType;
+    static bool classof(const Node* node) { return node->kind == NodeKind::UnsizedArrayType; }
 };
 
 /// Function type, consisting of domain and codomain types.
@@ -381,12 +479,15 @@ struct FnType : public Type {
     Ptr<Type> to;
 
     FnType(const Loc& loc, Ptr<Type>&& from, Ptr<Type>&& to)
-        : Type(loc), from(std::move(from)), to(std::move(to))
+        : Type(NodeKind::FnType, loc), from(std::move(from)), to(std::move(to))
     {}
 
     const artic::Type* infer(TypeChecker&) override;
     void bind(NameBinder&) override;
     void print(Printer&) const override;
+
+    using ClassOf = FnType;
+    static bool classof(const Node* node) { return node->kind == NodeKind::FnType; }
 };
 
 struct PtrType : public Type {
@@ -395,12 +496,15 @@ struct PtrType : public Type {
     size_t addr_space;
 
     PtrType(const Loc& loc, Ptr<Type>&& pointee, bool is_mut, size_t addr_space)
-        : Type(loc), pointee(std::move(pointee)), is_mut(is_mut), addr_space(addr_space)
+        : Type(NodeKind::PtrType, loc), pointee(std::move(pointee)), is_mut(is_mut), addr_space(addr_space)
     {}
 
     const artic::Type* infer(TypeChecker&) override;
     void bind(NameBinder&) override;
     void print(Printer&) const override;
+
+    using ClassOf = PtrType;
+    static bool classof(const Node* node) { return node->kind == NodeKind::PtrType; }
 };
 
 /// A type application.
@@ -408,33 +512,42 @@ struct TypeApp : public Type {
     Path path;
 
     TypeApp(const Loc& loc, Path&& path)
-        : Type(loc), path(std::move(path))
+        : Type(NodeKind::TypeApp, loc), path(std::move(path))
     {}
 
     const artic::Type* infer(TypeChecker&) override;
     void bind(NameBinder&) override;
     void print(Printer&) const override;
+
+    using ClassOf = TypeApp;
+    static bool classof(const Node* node) { return node->kind == NodeKind::TypeApp; }
 };
 
 /// The codomain of functions that don't return anything.
 struct NoCodomType : public Type {
     NoCodomType(const Loc& loc)
-        : Type(loc)
+        : Type(NodeKind::NoCodomType, loc)
     {}
 
     const artic::Type* infer(TypeChecker&) override;
     void bind(NameBinder&) override;
     void print(Printer&) const override;
+
+    using ClassOf = NoCodomType;
+    static bool classof(const Node* node) { return node->kind == NodeKind::NoCodomType; }
 };
 
 /// Type resulting from a parsing error.
 struct ErrorType : public Type {
     ErrorType(const Loc& loc)
-        : Type(loc)
+        : Type(NodeKind::ErrorType, loc)
     {}
 
     void bind(NameBinder&) override;
     void print(Printer&) const override;
+
+    using ClassOf = ErrorType;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ErrorType; }
 };
 
 // Statements ----------------------------------------------------------------------
@@ -444,7 +557,7 @@ struct DeclStmt : public Stmt {
     Ptr<Decl> decl;
 
     DeclStmt(const Loc& loc, Ptr<Decl>&& decl)
-        : Stmt(loc), decl(std::move(decl))
+        : Stmt(NodeKind::DeclStmt, loc), decl(std::move(decl))
     {}
 
     bool is_jumping() const override;
@@ -457,6 +570,9 @@ struct DeclStmt : public Stmt {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = DeclStmt;
+    static bool classof(const Node* node) { return node->kind == NodeKind::DeclStmt; }
 };
 
 // Statement evaluating an expression.
@@ -464,7 +580,7 @@ struct ExprStmt : public Stmt {
     Ptr<Expr> expr;
 
     ExprStmt(const Loc& loc, Ptr<Expr>&& expr)
-        : Stmt(loc), expr(std::move(expr))
+        : Stmt(NodeKind::ExprStmt, loc), expr(std::move(expr))
     {}
 
     bool is_jumping() const override;
@@ -477,6 +593,9 @@ struct ExprStmt : public Stmt {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = ExprStmt;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ExprStmt; }
 };
 
 // Expressions ---------------------------------------------------------------------
@@ -487,7 +606,7 @@ struct TypedExpr : public Expr {
     Ptr<Type> type;
 
     TypedExpr(const Loc& loc, Ptr<Expr>&& expr, Ptr<Type>&& type)
-        : Expr(loc)
+        : Expr(NodeKind::TypedExpr, loc)
         , expr(std::move(expr))
         , type(std::move(type))
     {}
@@ -501,6 +620,9 @@ struct TypedExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = TypedExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::TypedExpr; }
 };
 
 /// Expression made of a path to an identifier.
@@ -508,7 +630,7 @@ struct PathExpr : public Expr {
     Path path;
 
     PathExpr(Path&& path)
-        : Expr(path.loc), path(std::move(path))
+        : Expr(NodeKind::PathExpr, path.loc), path(std::move(path))
     {}
 
     bool is_constant() const override;
@@ -519,6 +641,9 @@ struct PathExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override {};
     void print(Printer&) const override;
+
+    using ClassOf = PathExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::PathExpr; }
 };
 
 /// Expression made of a literal.
@@ -526,7 +651,7 @@ struct LiteralExpr : public Expr {
     Literal lit;
 
     LiteralExpr(const Loc& loc, const Literal& lit)
-        : Expr(loc), lit(lit)
+        : Expr(NodeKind::LiteralExpr, loc), lit(lit)
     {}
 
     bool is_constant() const override;
@@ -537,6 +662,9 @@ struct LiteralExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override {};
     void print(Printer&) const override;
+
+    using ClassOf = LiteralExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::LiteralExpr; }
 };
 
 /// Expression summoning an implicit value.
@@ -546,7 +674,7 @@ struct SummonExpr : public Expr {
     const Expr* resolved = nullptr;
 
     SummonExpr(const Loc& loc, Ptr<Type>&& type_expr)
-        : Expr(loc), type_expr(std::move(type_expr))
+        : Expr(NodeKind::SummonExpr, loc), type_expr(std::move(type_expr))
     {}
 
     const thorin::Def* emit(Emitter&) const override;
@@ -555,6 +683,9 @@ struct SummonExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = SummonExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::SummonExpr; }
 };
 
 /// Field expression, part of a record expression.
@@ -568,7 +699,7 @@ struct FieldExpr : public Expr {
         const Loc& loc,
         Identifier&& id,
         Ptr<Expr>&& expr)
-        : Expr(loc)
+        : Expr(NodeKind::FieldExpr, loc)
         , id(std::move(id))
         , expr(std::move(expr))
     {}
@@ -584,6 +715,9 @@ struct FieldExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = FieldExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::FieldExpr; }
 };
 
 /// Record-like braced expression containing fields
@@ -601,7 +735,7 @@ struct RecordExpr : public Expr {
         const Loc& loc,
         Ptr<Type>&& type,
         PtrVector<FieldExpr>&& fields)
-        : Expr(loc)
+        : Expr(NodeKind::RecordExpr, loc)
         , type(std::move(type))
         , fields(std::move(fields))
     {}
@@ -611,7 +745,7 @@ struct RecordExpr : public Expr {
         const Loc& loc,
         Ptr<Expr>&& expr,
         PtrVector<FieldExpr>&& fields)
-        : Expr(loc)
+        : Expr(NodeKind::RecordExpr, loc)
         , expr(std::move(expr))
         , fields(std::move(fields))
     {}
@@ -625,6 +759,9 @@ struct RecordExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = RecordExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::RecordExpr; }
 };
 
 /// Expression enclosed by parenthesis and made of several expressions separated by commas.
@@ -632,7 +769,7 @@ struct TupleExpr : public Expr {
     PtrVector<Expr> args;
 
     TupleExpr(const Loc& loc, PtrVector<Expr>&& args)
-        : Expr(loc), args(std::move(args))
+        : Expr(NodeKind::TupleExpr, loc), args(std::move(args))
     {}
 
     bool is_jumping() const override;
@@ -645,6 +782,9 @@ struct TupleExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = TupleExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::TupleExpr; }
 };
 
 /// Array expression.
@@ -653,7 +793,7 @@ struct ArrayExpr : public Expr {
     bool is_simd;
 
     ArrayExpr(const Loc& loc, PtrVector<Expr>&& elems, bool is_simd)
-        : Expr(loc), elems(std::move(elems)), is_simd(is_simd)
+        : Expr(NodeKind::ArrayExpr, loc), elems(std::move(elems)), is_simd(is_simd)
     {}
 
     bool is_jumping() const override;
@@ -666,6 +806,9 @@ struct ArrayExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = ArrayExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ArrayExpr; }
 };
 
 /// Array expression repeating a given value a given number of times.
@@ -675,7 +818,7 @@ struct RepeatArrayExpr : public Expr {
     bool is_simd;
 
     RepeatArrayExpr(const Loc& loc, Ptr<Expr>&& elem, std::variant<size_t, ast::Path>&& size, bool is_simd)
-        : Expr(loc), elem(std::move(elem)), size(std::move(size)), is_simd(is_simd)
+        : Expr(NodeKind::RepeatArrayExpr, loc), elem(std::move(elem)), size(std::move(size)), is_simd(is_simd)
     {}
 
     bool is_jumping() const override;
@@ -688,6 +831,9 @@ struct RepeatArrayExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = RepeatArrayExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::RepeatArrayExpr; }
 };
 
 /// Anonymous function expression.
@@ -703,7 +849,7 @@ struct FnExpr : public Expr {
         Ptr<Ptrn>&& param,
         Ptr<Type>&& ret_type,
         Ptr<Expr>&& body)
-        : Expr(loc)
+        : Expr(NodeKind::FnExpr, loc)
         , filter(std::move(filter))
         , param(std::move(param))
         , ret_type(std::move(ret_type))
@@ -719,6 +865,9 @@ struct FnExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = FnExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::FnExpr; }
 };
 
 /// Block of code, whose result is the last expression in the block.
@@ -727,7 +876,7 @@ struct BlockExpr : public Expr {
     bool last_semi;
 
     BlockExpr(const Loc& loc, PtrVector<Stmt>&& stmts, bool last_semi)
-        : Expr(loc), stmts(std::move(stmts)), last_semi(last_semi)
+        : Expr(NodeKind::BlockExpr, loc), stmts(std::move(stmts)), last_semi(last_semi)
     {}
 
     bool is_jumping() const override;
@@ -739,6 +888,9 @@ struct BlockExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = BlockExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::BlockExpr; }
 };
 
 /// Function or constructor call with a single expression (can be a tuple) for the arguments.
@@ -747,7 +899,7 @@ struct CallExpr : public Expr {
     Ptr<Expr> arg;
 
     CallExpr(const Loc& loc, Ptr<Expr>&& callee, Ptr<Expr>&& arg)
-        : Expr(loc)
+        : Expr(NodeKind::CallExpr, loc)
         , callee(std::move(callee))
         , arg(std::move(arg))
     {}
@@ -762,6 +914,9 @@ struct CallExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = CallExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::CallExpr; }
 };
 
 /// Projection operator (.).
@@ -773,14 +928,14 @@ struct ProjExpr : public Expr {
 
     /// Constructor for projection expressions of the form `x.y`
     ProjExpr(const Loc& loc, Ptr<Expr>&& expr, Identifier&& field)
-        : Expr(loc)
+        : Expr(NodeKind::ProjExpr, loc)
         , expr(std::move(expr))
         , field(std::move(field))
     {}
 
     /// Constructor for projection expressions of the form `x.0`
     ProjExpr(const Loc& loc, Ptr<Expr>&& expr, size_t index)
-        : Expr(loc)
+        : Expr(NodeKind::ProjExpr, loc)
         , expr(std::move(expr))
         , field(index)
     {}
@@ -795,6 +950,9 @@ struct ProjExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = ProjExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ProjExpr; }
 };
 
 /// If/Else expression (the else branch is optional).
@@ -811,7 +969,7 @@ struct IfExpr : public Expr {
         Ptr<Expr>&& cond,
         Ptr<Expr>&& if_true,
         Ptr<Expr>&& if_false)
-        : Expr(loc)
+        : Expr(NodeKind::IfExpr, loc)
         , cond(std::move(cond))
         , if_true(std::move(if_true))
         , if_false(std::move(if_false))
@@ -824,7 +982,7 @@ struct IfExpr : public Expr {
             Ptr<Expr>&& expr,
             Ptr<Expr>&& if_true,
             Ptr<Expr>&& if_false)
-            : Expr(loc)
+            : Expr(NodeKind::IfExpr, loc)
             , ptrn(std::move(ptrn))
             , expr(std::move(expr))
             , if_true(std::move(if_true))
@@ -840,6 +998,9 @@ struct IfExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = IfExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::IfExpr; }
 };
 
 /// Case within a match expression.
@@ -848,7 +1009,7 @@ struct CaseExpr : public Expr {
     Ptr<Expr> expr;
 
     CaseExpr(const Loc& loc, Ptr<Ptrn>&& ptrn, Ptr<Expr>&& expr)
-        : Expr(loc)
+        : Expr(NodeKind::CaseExpr, loc)
         , ptrn(std::move(ptrn))
         , expr(std::move(expr))
     {}
@@ -859,6 +1020,9 @@ struct CaseExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = CaseExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::CaseExpr; }
 };
 
 /// Match expression.
@@ -867,7 +1031,7 @@ struct MatchExpr : public Expr {
     PtrVector<CaseExpr> cases;
 
     MatchExpr(const Loc& loc, Ptr<Expr>&& arg, PtrVector<CaseExpr>&& cases)
-        : Expr(loc)
+        : Expr(NodeKind::MatchExpr, loc)
         , arg(std::move(arg))
         , cases(std::move(cases))
     {}
@@ -881,6 +1045,9 @@ struct MatchExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = MatchExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::MatchExpr; }
 };
 
 /// Base class for loop expressions (while, for)
@@ -889,9 +1056,14 @@ struct LoopExpr : public Expr {
     mutable const thorin::Def* break_ = nullptr;
     mutable const thorin::Def* continue_ = nullptr;
 
-    LoopExpr(const Loc& loc)
-        : Expr(loc)
+    LoopExpr(NodeKind kind, const Loc& loc)
+        : Expr(kind, loc)
     {}
+
+    using ClassOf = LoopExpr;
+    static bool classof(const Node* node) {
+        return node->kind >= NodeKind::WhileExpr && node->kind <= NodeKind::ForExpr;
+    }
 };
 
 /// While loop expression.
@@ -903,12 +1075,12 @@ struct WhileExpr : public LoopExpr {
 
     // Constructor for the conditional form: `while cond { body }`
     WhileExpr(const Loc& loc, Ptr<Expr>&& cond, Ptr<Expr>&& body)
-        : LoopExpr(loc), cond(std::move(cond)), body(std::move(body))
+        : LoopExpr(NodeKind::WhileExpr, loc), cond(std::move(cond)), body(std::move(body))
     {}
 
     // Constructor for the pattern form: `while let ptrn = expr { body }`
     WhileExpr(const Loc& loc, Ptr<Ptrn>&& ptrn, Ptr<Expr>&& expr, Ptr<Expr>&& body)
-            : LoopExpr(loc), ptrn(std::move(ptrn)), expr(std::move(expr)), body(std::move(body))
+            : LoopExpr(NodeKind::WhileExpr, loc), ptrn(std::move(ptrn)), expr(std::move(expr)), body(std::move(body))
     {}
 
     bool is_jumping() const override;
@@ -919,6 +1091,9 @@ struct WhileExpr : public LoopExpr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = WhileExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::WhileExpr; }
 };
 
 /// For loop expression.
@@ -926,7 +1101,7 @@ struct ForExpr : public LoopExpr {
     Ptr<CallExpr> call;
 
     ForExpr(const Loc& loc, Ptr<CallExpr>&& call)
-        : LoopExpr(loc), call(std::move(call))
+        : LoopExpr(NodeKind::ForExpr, loc), call(std::move(call))
     {}
 
     bool is_jumping() const override;
@@ -937,6 +1112,9 @@ struct ForExpr : public LoopExpr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = ForExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ForExpr; }
 };
 
 /// Break expression.
@@ -944,7 +1122,7 @@ struct BreakExpr : public Expr {
     const LoopExpr* loop = nullptr;
 
     BreakExpr(const Loc& loc)
-        : Expr(loc)
+        : Expr(NodeKind::BreakExpr, loc)
     {}
 
     const thorin::Def* emit(Emitter&) const override;
@@ -952,6 +1130,9 @@ struct BreakExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override {};
     void print(Printer&) const override;
+
+    using ClassOf = BreakExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::BreakExpr; }
 };
 
 /// Break expression.
@@ -959,7 +1140,7 @@ struct ContinueExpr : public Expr {
     const LoopExpr* loop = nullptr;
 
     ContinueExpr(const Loc& loc)
-        : Expr(loc)
+        : Expr(NodeKind::ContinueExpr, loc)
     {}
 
     const thorin::Def* emit(Emitter&) const override;
@@ -967,6 +1148,9 @@ struct ContinueExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override {};
     void print(Printer&) const override;
+
+    using ClassOf = ContinueExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ContinueExpr; }
 };
 
 /// Break expression.
@@ -974,7 +1158,7 @@ struct ReturnExpr : public Expr {
     const FnExpr* fn = nullptr;
 
     ReturnExpr(const Loc& loc)
-        : Expr(loc)
+        : Expr(NodeKind::ReturnExpr, loc)
     {}
 
     const thorin::Def* emit(Emitter&) const override;
@@ -982,6 +1166,9 @@ struct ReturnExpr : public Expr {
     void resolve_summons(Summoner&) override {};
     void bind(NameBinder&) override;
     void print(Printer&) const override;
+
+    using ClassOf = ReturnExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ReturnExpr; }
 };
 
 /// Unary expression (negation, increment, ...).
@@ -1005,7 +1192,7 @@ struct UnaryExpr : public Expr {
     Ptr<Expr> arg;
 
     UnaryExpr(const Loc& loc, Tag tag, Ptr<Expr>&& arg)
-        : Expr(loc), tag(tag), arg(std::move(arg))
+        : Expr(NodeKind::UnaryExpr, loc), tag(tag), arg(std::move(arg))
     {}
 
     bool is_prefix() const { return !is_postfix(); }
@@ -1030,6 +1217,9 @@ struct UnaryExpr : public Expr {
 
     static std::string tag_to_string(Tag);
     static Tag tag_from_token(const Token&, bool);
+
+    using ClassOf = UnaryExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::UnaryExpr; }
 };
 
 /// Binary expression (addition, logical operations, ...).
@@ -1054,7 +1244,7 @@ struct BinaryExpr : public Expr {
         Tag tag,
         Ptr<Expr>&& left,
         Ptr<Expr>&& right)
-        : Expr(loc), tag(tag), left(std::move(left)), right(std::move(right))
+        : Expr(NodeKind::BinaryExpr, loc), tag(tag), left(std::move(left)), right(std::move(right))
     {}
 
     bool has_eq() const { return has_eq(tag); }
@@ -1085,6 +1275,9 @@ struct BinaryExpr : public Expr {
 
     static std::string tag_to_string(Tag);
     static Tag tag_from_token(const Token&);
+
+    using ClassOf = BinaryExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::BinaryExpr; }
 };
 
 /// Filter expression to force execution of calls.
@@ -1096,7 +1289,7 @@ struct FilterExpr : public Expr {
         const Loc& loc,
         Ptr<ast::Filter>&& filter,
         Ptr<Expr>&& expr)
-        : Expr(loc)
+        : Expr(NodeKind::FilterExpr, loc)
         , filter(std::move(filter))
         , expr(std::move(expr))
     {}
@@ -1108,6 +1301,9 @@ struct FilterExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = FilterExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::FilterExpr; }
 };
 
 /// Explicit cast using the `as` operator.
@@ -1119,7 +1315,7 @@ struct CastExpr : public Expr {
         const Loc& loc,
         Ptr<Expr>&& expr,
         Ptr<Type>&& type)
-        : Expr(loc), expr(std::move(expr)), type(std::move(type))
+        : Expr(NodeKind::CastExpr, loc), expr(std::move(expr)), type(std::move(type))
     {}
 
     bool is_jumping() const override;
@@ -1131,6 +1327,9 @@ struct CastExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = CastExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::CastExpr; }
 };
 
 /// Implicit cast expression, inserted during type-checking.
@@ -1141,7 +1340,7 @@ struct ImplicitCastExpr : public Expr {
         const Loc& loc,
         Ptr<Expr>&& expr,
         const artic::Type* type)
-        : Expr(loc), expr(std::move(expr))
+        : Expr(NodeKind::ImplicitCastExpr, loc), expr(std::move(expr))
     {
         this->type = type;
     }
@@ -1154,6 +1353,9 @@ struct ImplicitCastExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = ImplicitCastExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ImplicitCastExpr; }
 };
 
 /// Inline assembly expression.
@@ -1179,7 +1381,7 @@ struct AsmExpr : public Expr {
         std::vector<Constr>&& outs,
         std::vector<std::string>&& clobs,
         std::vector<std::string>&& opts)
-        : Expr(loc)
+        : Expr(NodeKind::AsmExpr, loc)
         , src(std::move(src))
         , ins(std::move(ins))
         , outs(std::move(outs))
@@ -1194,17 +1396,23 @@ struct AsmExpr : public Expr {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = AsmExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::AsmExpr; }
 };
 
 /// Incorrect expression, as a result of parsing.
 struct ErrorExpr : public Expr {
     ErrorExpr(const Loc& loc)
-        : Expr(loc)
+        : Expr(NodeKind::ErrorExpr, loc)
     {}
 
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override {};
     void print(Printer&) const override;
+
+    using ClassOf = ErrorExpr;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ErrorExpr; }
 };
 
 // Declarations --------------------------------------------------------------------
@@ -1213,35 +1421,53 @@ struct ErrorExpr : public Expr {
 struct NamedDecl : public Decl {
     Identifier id;
 
-    NamedDecl(const Loc& loc, Identifier&& id)
-        : Decl(loc), id(std::move(id))
+    NamedDecl(NodeKind kind, const Loc& loc, Identifier&& id)
+        : Decl(kind, loc), id(std::move(id))
     {}
+
+    using ClassOf = NamedDecl;
+    static bool classof(const Node* node) {
+        return node->kind >= NodeKind::PtrnDecl && node->kind <= NodeKind::UseDecl;
+    }
 };
 
 /// Value declaration associated with an identifier.
 struct ValueDecl : public NamedDecl {
-    ValueDecl(const Loc& loc, Identifier&& id)
-        : NamedDecl(loc, std::move(id))
+    ValueDecl(NodeKind kind, const Loc& loc, Identifier&& id)
+        : NamedDecl(kind, loc, std::move(id))
     {}
+
+    using ClassOf = ValueDecl;
+    static bool classof(const Node* node) {
+        return node->kind >= NodeKind::PtrnDecl && node->kind <= NodeKind::FnDecl;
+    }
 };
 
 /// Datatype declaration with a constructor associated with an identifier.
 struct CtorDecl : public NamedDecl {
-    CtorDecl(const Loc& loc, Identifier&& id)
-        : NamedDecl(loc, std::move(id))
+    CtorDecl(NodeKind kind, const Loc& loc, Identifier&& id)
+        : NamedDecl(kind, loc, std::move(id))
     {}
+
+    using ClassOf = CtorDecl;
+    static bool classof(const Node* node) {
+        return node->kind >= NodeKind::StructDecl && node->kind <= NodeKind::EnumDecl;
+    }
 };
 
 /// Type parameter, introduced by the operator [].
 struct TypeParam : public NamedDecl {
     TypeParam(const Loc& loc, Identifier&& id)
-        : NamedDecl(loc, std::move(id))
+        : NamedDecl(NodeKind::TypeParam, loc, std::move(id))
     {}
 
     const artic::Type* infer(TypeChecker&) override;
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override {};
     void print(Printer&) const override;
+
+    using ClassOf = TypeParam;
+    static bool classof(const Node* node) { return node->kind == NodeKind::TypeParam; }
 };
 
 /// Type parameter list, of the form [T, U, ...]
@@ -1249,12 +1475,15 @@ struct TypeParamList : public Node {
     PtrVector<TypeParam> params;
 
     TypeParamList(const Loc& loc, PtrVector<TypeParam>&& params)
-        : Node(loc), params(std::move(params))
+        : Node(NodeKind::TypeParamList, loc), params(std::move(params))
     {}
 
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override {};
     void print(Printer&) const override;
+
+    using ClassOf = TypeParamList;
+    static bool classof(const Node* node) { return node->kind == NodeKind::TypeParamList; }
 };
 
 /// Pattern binding associated with an identifier.
@@ -1265,13 +1494,16 @@ struct PtrnDecl : public ValueDecl {
     mutable bool written_to = false;
 
     PtrnDecl(const Loc& loc, Identifier&& id, bool is_mut = false)
-        : ValueDecl(loc, std::move(id)), is_mut(is_mut)
+        : ValueDecl(NodeKind::PtrnDecl, loc, std::move(id)), is_mut(is_mut)
     {}
 
     const artic::Type* check(TypeChecker&, const artic::Type*) override;
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override {};
     void print(Printer&) const override;
+
+    using ClassOf = PtrnDecl;
+    static bool classof(const Node* node) { return node->kind == NodeKind::PtrnDecl; }
 };
 
 /// Declaration that introduces a new symbol in the scope, with an optional initializer.
@@ -1280,7 +1512,7 @@ struct LetDecl : public Decl {
     Ptr<Expr> init;
 
     LetDecl(const Loc& loc, Ptr<Ptrn>&& ptrn, Ptr<Expr>&& init)
-        : Decl(loc)
+        : Decl(NodeKind::LetDecl, loc)
         , ptrn(std::move(ptrn))
         , init(std::move(init))
     {}
@@ -1290,6 +1522,9 @@ struct LetDecl : public Decl {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = LetDecl;
+    static bool classof(const Node* node) { return node->kind == NodeKind::LetDecl; }
 };
 
 /// Declaration that introduces an implicit value, or implicit value generator in the scope
@@ -1302,7 +1537,7 @@ struct ImplicitDecl : public Decl {
                  Ptr<Type>&& type,
                  Ptr<Expr>&& value,
                  bool is_generator = false)
-            : Decl(loc)
+            : Decl(NodeKind::ImplicitDecl, loc)
             , type(std::move(type))
             , value(std::move(value))
             , is_generator(is_generator)
@@ -1313,6 +1548,9 @@ struct ImplicitDecl : public Decl {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = ImplicitDecl;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ImplicitDecl; }
 };
 
 /// Static (top-level) declaration.
@@ -1329,7 +1567,7 @@ struct StaticDecl : public ValueDecl {
         Ptr<Type>&& type,
         Ptr<Expr>&& init,
         bool is_mut = false)
-        : ValueDecl(loc, std::move(id))
+        : ValueDecl(NodeKind::StaticDecl, loc, std::move(id))
         , type(std::move(type))
         , init(std::move(init))
         , is_mut(is_mut)
@@ -1341,6 +1579,9 @@ struct StaticDecl : public ValueDecl {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = StaticDecl;
+    static bool classof(const Node* node) { return node->kind == NodeKind::StaticDecl; }
 };
 
 /// Function declaration.
@@ -1353,7 +1594,7 @@ struct FnDecl : public ValueDecl {
         Identifier&& id,
         Ptr<FnExpr>&& fn,
         Ptr<TypeParamList>&& type_params)
-        : ValueDecl(loc, std::move(id))
+        : ValueDecl(NodeKind::FnDecl, loc, std::move(id))
         , fn(std::move(fn))
         , type_params(std::move(type_params))
     {}
@@ -1365,6 +1606,9 @@ struct FnDecl : public ValueDecl {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = FnDecl;
+    static bool classof(const Node* node) { return node->kind == NodeKind::FnDecl; }
 };
 
 /// Structure field declaration.
@@ -1377,7 +1621,7 @@ struct FieldDecl : public NamedDecl {
         Identifier&& id,
         Ptr<Type>&& type,
         Ptr<Expr>&& init)
-        : NamedDecl(loc, std::move(id))
+        : NamedDecl(NodeKind::FieldDecl, loc, std::move(id))
         , type(std::move(type))
         , init(std::move(init))
     {}
@@ -1386,21 +1630,29 @@ struct FieldDecl : public NamedDecl {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = FieldDecl;
+    static bool classof(const Node* node) { return node->kind == NodeKind::FieldDecl; }
 };
 
 /// Base class for declarations holding fields.
 struct RecordDecl : public CtorDecl {
     PtrVector<FieldDecl> fields;
 
-    RecordDecl(
+    RecordDecl(NodeKind kind, 
         const Loc& loc,
         Identifier&& id,
         PtrVector<FieldDecl>&& fields)
-        : CtorDecl(loc, std::move(id))
+        : CtorDecl(kind, loc, std::move(id))
         , fields(std::move(fields))
     {}
 
     void resolve_summons(Summoner&) override;
+
+    using ClassOf = RecordDecl;
+    static bool classof(const Node* node) {
+        return node->kind >= NodeKind::StructDecl && node->kind <= NodeKind::OptionDecl;
+    }
 };
 
 /// Structure type declarations.
@@ -1414,7 +1666,7 @@ struct StructDecl : public RecordDecl {
         Ptr<TypeParamList>&& type_params,
         PtrVector<FieldDecl>&& fields,
         bool is_tuple_like)
-        : RecordDecl(loc, std::move(id), std::move(fields))
+        : RecordDecl(NodeKind::StructDecl, loc, std::move(id), std::move(fields))
         , type_params(std::move(type_params))
         , is_tuple_like(is_tuple_like)
     {}
@@ -1424,6 +1676,9 @@ struct StructDecl : public RecordDecl {
     void bind_head(NameBinder&) override;
     void bind(NameBinder&) override;
     void print(Printer&) const override;
+
+    using ClassOf = StructDecl;
+    static bool classof(const Node* node) { return node->kind == NodeKind::StructDecl; }
 };
 
 struct EnumDecl;
@@ -1446,7 +1701,7 @@ struct OptionDecl : public RecordDecl {
         Ptr<Type>&& param,
         PtrVector<FieldDecl>&& fields,
         bool has_fields)
-        : RecordDecl(loc, std::move(id), std::move(fields))
+        : RecordDecl(NodeKind::OptionDecl, loc, std::move(id), std::move(fields))
         , param(std::move(param))
         , has_fields(has_fields)
     {}
@@ -1455,6 +1710,9 @@ struct OptionDecl : public RecordDecl {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override {};
     void print(Printer&) const override;
+
+    using ClassOf = OptionDecl;
+    static bool classof(const Node* node) { return node->kind == NodeKind::OptionDecl; }
 };
 
 /// Enumeration declaration.
@@ -1467,7 +1725,7 @@ struct EnumDecl : public CtorDecl {
         Identifier&& id,
         Ptr<TypeParamList>&& type_params,
         PtrVector<OptionDecl>&& options)
-        : CtorDecl(loc, std::move(id))
+        : CtorDecl(NodeKind::EnumDecl, loc, std::move(id))
         , type_params(std::move(type_params))
         , options(std::move(options))
     {}
@@ -1478,6 +1736,9 @@ struct EnumDecl : public CtorDecl {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override {};
     void print(Printer&) const override;
+
+    using ClassOf = EnumDecl;
+    static bool classof(const Node* node) { return node->kind == NodeKind::EnumDecl; }
 };
 
 /// Type alias declaration.
@@ -1490,7 +1751,7 @@ struct TypeDecl : public NamedDecl {
         Identifier&& id,
         Ptr<TypeParamList>&& type_params,
         Ptr<Type>&& aliased_type)
-        : NamedDecl(loc, std::move(id))
+        : NamedDecl(NodeKind::TypeDecl, loc, std::move(id))
         , type_params(std::move(type_params))
         , aliased_type(std::move(aliased_type))
     {}
@@ -1501,6 +1762,9 @@ struct TypeDecl : public NamedDecl {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override {};
     void print(Printer&) const override;
+
+    using ClassOf = TypeDecl;
+    static bool classof(const Node* node) { return node->kind == NodeKind::TypeDecl; }
 };
 
 /// Module definition.
@@ -1508,18 +1772,16 @@ struct ModDecl : public NamedDecl {
     PtrVector<Decl> decls;
     ModDecl* super = nullptr;
 
-    std::vector<const NamedDecl*> members;
-
     /// Constructor for the implicitly defined global module.
     /// When using this constructor, the user is responsible for calling
     /// `set_super()` once the declarations have been added to the module.
-    explicit ModDecl()
-        : NamedDecl(Loc(), Identifier())
+    explicit ModDecl(Arena& arena)
+        : NamedDecl(NodeKind::ModDecl, Loc(), Identifier()), decls(arena)
     {}
 
     /// Constructor for a regular module declaration.
     ModDecl(const Loc& loc, Identifier&& id, PtrVector<Decl>&& decls)
-        : NamedDecl(loc, std::move(id)), decls(std::move(decls))
+        : NamedDecl(NodeKind::ModDecl, loc, std::move(id)), decls(std::move(decls))
     {
         set_super();
     }
@@ -1532,6 +1794,9 @@ struct ModDecl : public NamedDecl {
     void bind(NameBinder&) override;
     void print(Printer&) const override;
     void resolve_summons(Summoner&) override;
+
+    using ClassOf = ModDecl;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ModDecl; }
 };
 
 /// Module use, with or without `as`.
@@ -1539,7 +1804,7 @@ struct UseDecl : public NamedDecl {
     Path path;
 
     UseDecl(const Loc& loc, Path&& path, Identifier&& id)
-        : NamedDecl(loc, std::move(id)), path(std::move(path))
+        : NamedDecl(NodeKind::UseDecl, loc, std::move(id)), path(std::move(path))
     {}
 
     const thorin::Def* emit(Emitter&) const override;
@@ -1548,15 +1813,21 @@ struct UseDecl : public NamedDecl {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override {};
     void print(Printer&) const override;
+
+    using ClassOf = UseDecl;
+    static bool classof(const Node* node) { return node->kind == NodeKind::UseDecl; }
 };
 
 /// Incorrect declaration, coming from parsing.
 struct ErrorDecl : public Decl {
-    ErrorDecl(const Loc& loc) : Decl(loc) {}
+    ErrorDecl(const Loc& loc) : Decl(NodeKind::ErrorDecl, loc) {}
 
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override {};
     void print(Printer&) const override;
+
+    using ClassOf = ErrorDecl;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ErrorDecl; }
 };
 
 // Patterns ------------------------------------------------------------------------
@@ -1567,7 +1838,7 @@ struct TypedPtrn : public Ptrn {
     Ptr<Type> type;
 
     TypedPtrn(const Loc& loc, Ptr<Ptrn>&& ptrn, Ptr<Type>&& type)
-        : Ptrn(loc), ptrn(std::move(ptrn)), type(std::move(type))
+        : Ptrn(NodeKind::TypedPtrn, loc), ptrn(std::move(ptrn)), type(std::move(type))
     {}
 
     void collect_bound_ptrns(std::vector<const IdPtrn*>&) const override;
@@ -1579,6 +1850,9 @@ struct TypedPtrn : public Ptrn {
     const Expr* to_expr(Arena&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = TypedPtrn;
+    static bool classof(const Node* node) { return node->kind == NodeKind::TypedPtrn; }
 };
 
 /// An identifier used as a pattern.
@@ -1587,7 +1861,7 @@ struct IdPtrn : public Ptrn {
     Ptr<Ptrn> sub_ptrn;
 
     IdPtrn(const Loc& loc, Ptr<PtrnDecl>&& decl, Ptr<Ptrn>&& sub_ptrn)
-        : Ptrn(loc), decl(std::move(decl)), sub_ptrn(std::move(sub_ptrn))
+        : Ptrn(NodeKind::IdPtrn, loc), decl(std::move(decl)), sub_ptrn(std::move(sub_ptrn))
     {}
 
     void collect_bound_ptrns(std::vector<const IdPtrn*>&) const override;
@@ -1600,6 +1874,9 @@ struct IdPtrn : public Ptrn {
     const Expr* to_expr(Arena&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = IdPtrn;
+    static bool classof(const Node* node) { return node->kind == NodeKind::IdPtrn; }
 };
 
 /// A literal used as a pattern.
@@ -1607,7 +1884,7 @@ struct LiteralPtrn : public Ptrn {
     Literal lit;
 
     LiteralPtrn(const Loc& loc, const Literal& lit)
-        : Ptrn(loc), lit(lit)
+        : Ptrn(NodeKind::LiteralPtrn, loc), lit(lit)
     {}
 
     bool is_trivial() const override;
@@ -1618,13 +1895,16 @@ struct LiteralPtrn : public Ptrn {
     const Expr* to_expr(Arena&) override;
     void resolve_summons(Summoner&) override {};
     void print(Printer&) const override;
+
+    using ClassOf = LiteralPtrn;
+    static bool classof(const Node* node) { return node->kind == NodeKind::LiteralPtrn; }
 };
 
 struct ImplicitParamPtrn : public Ptrn {
     Ptr<Ptrn> underlying;
 
     ImplicitParamPtrn(const Loc& loc, Ptr<Ptrn>&& underlying)
-        : Ptrn(loc), underlying(std::move(underlying))
+        : Ptrn(NodeKind::ImplicitParamPtrn, loc), underlying(std::move(underlying))
     {}
 
     bool is_trivial() const override;
@@ -1635,6 +1915,9 @@ struct ImplicitParamPtrn : public Ptrn {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = ImplicitParamPtrn;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ImplicitParamPtrn; }
 };
 
 /// A pattern that matches against a structure field.
@@ -1645,7 +1928,7 @@ struct FieldPtrn : public Ptrn {
     size_t index;
 
     FieldPtrn(const Loc& loc, Identifier&& id, Ptr<Ptrn>&& ptrn)
-        : Ptrn(loc), id(std::move(id)), ptrn(std::move(ptrn))
+        : Ptrn(NodeKind::FieldPtrn, loc), id(std::move(id)), ptrn(std::move(ptrn))
     {}
 
     bool is_etc() const { return !ptrn; }
@@ -1658,6 +1941,9 @@ struct FieldPtrn : public Ptrn {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = FieldPtrn;
+    static bool classof(const Node* node) { return node->kind == NodeKind::FieldPtrn; }
 };
 
 /// A pattern that matches against record-like types with named fields.
@@ -1669,7 +1955,7 @@ struct RecordPtrn : public Ptrn {
     size_t variant_index = 0;
 
     RecordPtrn(const Loc& loc, Path&& path, PtrVector<FieldPtrn>&& fields)
-        : Ptrn(loc), path(std::move(path)), fields(std::move(fields))
+        : Ptrn(NodeKind::RecordPtrn, loc), path(std::move(path)), fields(std::move(fields))
     {}
 
     bool has_etc() const { return !fields.empty() && fields.back()->is_etc(); }
@@ -1682,6 +1968,9 @@ struct RecordPtrn : public Ptrn {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = RecordPtrn;
+    static bool classof(const Node* node) { return node->kind == NodeKind::RecordPtrn; }
 };
 
 /// A pattern that matches against constructor invocations.
@@ -1693,7 +1982,7 @@ struct CtorPtrn : public Ptrn {
     size_t variant_index = 0;
 
     CtorPtrn(const Loc& loc, Path&& path, Ptr<Ptrn>&& arg)
-        : Ptrn(loc), path(std::move(path)), arg(std::move(arg))
+        : Ptrn(NodeKind::CtorPtrn, loc), path(std::move(path)), arg(std::move(arg))
     {}
 
     void collect_bound_ptrns(std::vector<const IdPtrn*>&) const override;
@@ -1704,6 +1993,9 @@ struct CtorPtrn : public Ptrn {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = CtorPtrn;
+    static bool classof(const Node* node) { return node->kind == NodeKind::CtorPtrn; }
 };
 
 /// A pattern that matches against tuples.
@@ -1711,7 +2003,7 @@ struct TuplePtrn : public Ptrn {
     PtrVector<Ptrn> args;
 
     TuplePtrn(const Loc& loc, PtrVector<Ptrn>&& args)
-        : Ptrn(loc), args(std::move(args))
+        : Ptrn(NodeKind::TuplePtrn, loc), args(std::move(args))
     {}
 
     void collect_bound_ptrns(std::vector<const IdPtrn*>&) const override;
@@ -1723,6 +2015,9 @@ struct TuplePtrn : public Ptrn {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = TuplePtrn;
+    static bool classof(const Node* node) { return node->kind == NodeKind::TuplePtrn; }
 };
 
 /// A pattern that matches arrays of fixed size.
@@ -1731,7 +2026,7 @@ struct ArrayPtrn : public Ptrn {
     bool is_simd;
 
     ArrayPtrn(const Loc& loc, PtrVector<Ptrn>&& elems, bool is_simd)
-        : Ptrn(loc), elems(std::move(elems)), is_simd(is_simd)
+        : Ptrn(NodeKind::ArrayPtrn, loc), elems(std::move(elems)), is_simd(is_simd)
     {}
 
     void collect_bound_ptrns(std::vector<const IdPtrn*>&) const override;
@@ -1743,17 +2038,23 @@ struct ArrayPtrn : public Ptrn {
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override;
     void print(Printer&) const override;
+
+    using ClassOf = ArrayPtrn;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ArrayPtrn; }
 };
 
 /// A pattern resulting from a parsing error.
 struct ErrorPtrn : public Ptrn {
-    ErrorPtrn(const Loc& loc) : Ptrn(loc) {}
+    ErrorPtrn(const Loc& loc) : Ptrn(NodeKind::ErrorPtrn, loc) {}
 
     bool is_trivial() const override;
 
     void bind(NameBinder&) override;
     void resolve_summons(Summoner&) override {};
     void print(Printer&) const override;
+
+    using ClassOf = ErrorPtrn;
+    static bool classof(const Node* node) { return node->kind == NodeKind::ErrorPtrn; }
 };
 
 } // namespace ast
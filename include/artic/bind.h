@@ -4,7 +4,6 @@
 #include <unordered_map>
 #include <string_view>
 #include <vector>
-#include <algorithm>
 
 #include "artic/symbol.h"
 #include "artic/ast.h"
@@ -39,54 +38,40 @@ public:
     void bind_head(ast::Decl&);
     void bind(ast::Node&);
 
-    void push_scope(bool top_level = false) { scopes_.emplace_back(top_level); }
+    void push_scope(bool top_level = false) { symbols_.push_scope(top_level); }
     void pop_scope();
-    void insert_symbol(ast::NamedDecl&, const std::string&);
+    void insert_symbol(ast::NamedDecl&, Name);
     void insert_symbol(ast::NamedDecl& decl) {
         insert_symbol(decl, decl.id.name);
     }
 
-    void remove_symbol(const std::string& name) {
-        for (auto it = scopes_.rbegin(); it != scopes_.rend(); it++) {
-            if (auto symbol = it->find(name)) {
-                it->erase(name);
-                return;
-            }
-        }
-    }
+    void remove_symbol(Name name) { symbols_.erase(name); }
 
-    Symbol* find_symbol(const std::string& name) {
-        for (auto it = scopes_.rbegin(); it != scopes_.rend(); it++) {
-            if (auto symbol = it->find(name)) {
-                symbol->use_count++;
-                return symbol;
-            }
-        }
-        return nullptr;
+    Symbol* find_symbol(Name name) {
+        auto symbol = symbols_.find(name);
+        if (symbol)
+            symbol->use_count++;
+        return symbol;
     }
 
-    Symbol* find_similar_symbol(const std::string& name) {
+    Symbol* find_similar_symbol(Name name) {
         Symbol* best = nullptr;
         auto min = levenshtein_threshold();
-        for (auto it = scopes_.rbegin(); it != scopes_.rend(); it++)
-            best = it->find_similar(name, min, levenshtein);
+        // Inner scopes are searched first: symbols of outer scopes are only
+        // suggested when they are strictly closer to the given name.
+        for (size_t i = symbols_.depth(); i-- > 0;) {
+            if (auto symbol = symbols_.find_similar(i, name, min, levenshtein))
+                best = symbol;
+        }
         return best;
     }
 
 private:
     // Levenshtein distance is used to suggest similar identifiers to the user
     static constexpr size_t levenshtein_threshold() { return 3; }
-    static size_t levenshtein(const std::string_view& a, const std::string_view& b, size_t max) {
-        if (max == 0 || a.empty() || b.empty())
-            return std::max(a.size(), b.size());
-        auto d = a.front() != b.front() ? 1 : 0;
-        auto d1 = levenshtein(a.substr(1), b, max - 1) + 1;
-        auto d2 = levenshtein(a, b.substr(1), max - 1) + 1;
-        auto d3 = levenshtein(a.substr(1), b.substr(1), max - d) + d;
-        return std::min(d1, std::min(d2, d3));
-    }
+    static size_t levenshtein(std::string_view, std::string_view, size_t);
 
-    std::vector<SymbolTable> scopes_;
+    SymbolTable symbols_;
 
     friend struct ast::ModDecl;
 };
@@ -6,25 +6,35 @@
 
 namespace artic {
 
+/// Detects whether the class `T` provides its own `static bool classof(const A*)` function.
+/// Such classes are tested with a tag comparison instead of RTTI. Since a `classof` inherited
+/// from a base class only checks the kinds of that base class, classes providing `classof`
+/// must also declare `using ClassOf = T;`: other classes fall back to `dynamic_cast`.
+template <typename T, typename A, typename = void>
+struct HasClassOf : std::false_type {};
+template <typename T, typename A>
+struct HasClassOf<T, A, std::void_t<decltype(T::classof(std::declval<A>())), typename T::ClassOf>>
+    : std::is_same<typename T::ClassOf, T>
+{};
+
 template <typename B, typename A>
-inline B as(A a) {
+inline B isa(A a) {
     static_assert(
         std::is_base_of<
             typename std::remove_pointer<A>::type,
             typename std::remove_pointer<B>::type>::value,
         "B is not a derived class of A");
-    assert(dynamic_cast<B>(a) != nullptr && "Invalid conversion at runtime");
-    return static_cast<B>(a);
+    using T = std::remove_cv_t<std::remove_pointer_t<B>>;
+    if constexpr (HasClassOf<T, A>::value)
+        return a && T::classof(a) ? static_cast<B>(a) : nullptr;
+    else
+        return dynamic_cast<B>(a);
 }
 
 template <typename B, typename A>
-inline B isa(A a) {
-    static_assert(
-        std::is_base_of<
-            typename std::remove_pointer<A>::type,
-            typename std::remove_pointer<B>::type>::value,
-        "B is not a derived class of A");
-    return dynamic_cast<B>(a);
+inline B as(A a) {
+    assert(isa<B>(a) != nullptr && "Invalid conversion at runtime");
+    return static_cast<B>(a);
 }
 
 template <typename T>
@@ -20,6 +20,9 @@ public:
 
     TypeTable& type_table;
 
+    /// Arena in which the AST is allocated.
+    Arena& arena() const { return _arena; }
+
     /// Performs type checking on a whole program.
     /// Returns true on success, otherwise false.
     bool run(ast::ModDecl&);
@@ -35,7 +38,7 @@ public:
     const Type* incompatible_types(const Loc&, const Type*, const Type*);
     const Type* incompatible_type(const Loc&, const std::string_view&, const Type*);
     const Type* type_expected(const Loc&, const Type*, const std::string_view&);
-    const Type* unknown_member(const Loc&, const UserType*, const std::string_view&);
+    const Type* unknown_member(const Loc&, const UserType*, Name);
     const Type* cannot_infer(const Loc&, const std::string_view&);
     const Type* unreachable_code(const Loc&, const Loc&, const Loc&);
     const Type* mutable_expected(const Loc&);
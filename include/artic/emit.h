@@ -2,6 +2,7 @@
 #define ARTIC_EMIT_H
 
 #include <string>
+#include <string_view>
 #include <cassert>
 
 #include <thorin/debug.h>
@@ -26,6 +27,11 @@ public:
     thorin::World& world;
     Arena& arena;
 
+    /// Attaches source locations and block names to the emitted definitions.
+    /// When disabled, definitions only keep the names of the declarations they
+    /// come from, which are needed to recognize built-in and exported functions.
+    bool debug = true;
+
     struct State {
         const thorin::Def* mem = nullptr;
         thorin::Continuation* cont = nullptr;
@@ -85,7 +91,7 @@ public:
     /// Map of all types to avoid converting the same type several times.
     std::unordered_map<const Type*, const thorin::Type*> types;
     /// Map from the currently bound type variables to monomorphic types.
-    std::unordered_map<const TypeVar*, const Type*> type_vars;
+    ReplaceMap type_vars;
     /// Map from monomorphic function signature to emitted thorin function.
     std::unordered_map<MonoFn, thorin::Continuation*, Hash, Compare> mono_fns;
     /// Map from enum type and variant index to variant constructor.
@@ -94,13 +100,37 @@ public:
     std::unordered_map<const Type*, const thorin::Def*> struct_ctors;
     /// Map from types to their generated comparison function, if any.
     std::unordered_map<const Type*, const thorin::Def*> comparators;
-    /// Vector containing definitions that are generated during monomorphization.
-    std::vector<std::vector<const thorin::Def**>> poly_defs;
+    /// Definitions of the nodes emitted for an instance of a polymorphic function.
+    using DefMap = std::unordered_map<const ast::Node*, const thorin::Def*>;
+    /// Instance of a polymorphic function, along with the definitions emitted for it.
+    struct Instance {
+        const ast::FnDecl* fn;
+        DefMap defs;
+    };
+    /// Stack of the polymorphic function instances being emitted, innermost last.
+    /// Definitions emitted within an instance are kept in its map, instead of the AST.
+    std::vector<Instance> instances;
+
+    /// Statistics about the decision trees generated for pattern matching.
+    struct MatchStats {
+        /// Number of inner nodes compiled in all decision trees (leaves are not counted).
+        size_t nodes = 0;
+        /// Number of nodes that share the code of an identical sub-tree.
+        size_t shared_nodes = 0;
+    };
+
+    MatchStats match_stats;
+
+    /// Names of the source files, as passed to thorin locations, indexed by file identifier.
+    std::unordered_map<FileId, const char*> file_names;
 
     bool run(const ast::ModDecl&);
 
     SavedState save_state() { return SavedState(*this); }
 
+    /// Replaces the currently bound type variables in the given type.
+    const Type* replace_type_vars(const Type*);
+
     void redundant_case(const ast::CaseExpr&);
     void non_exhaustive_match(const ast::MatchExpr&);
 
@@ -131,6 +161,11 @@ public:
     const thorin::Def* no_ret();
     const thorin::Def* down_cast(const thorin::Def*, const Type*, const Type*, thorin::Debug = {});
 
+    /// Returns the definition of a node for the current instance, if it has been emitted.
+    const thorin::Def* def(const ast::Node&) const;
+    /// Sets the definition of a node for the current instance.
+    void set_def(const ast::Node&, const thorin::Def*);
+
     const thorin::Def* emit(const ast::Node&);
     void emit(const ast::Ptrn&, const thorin::Def*);
     void bind(const ast::IdPtrn&, const thorin::Def*);
@@ -143,16 +178,20 @@ public:
     thorin::Debug debug_info(const ast::Node&, const std::string_view& = "");
 
 private:
+    thorin::Loc location(const Loc&);
     const thorin::Def* cast_pointers(const thorin::Def*, const AddrType*, const AddrType*, thorin::Debug);
 };
 
 /// Helper function to compile a set of files and generate an AST and a thorin module.
 /// Errors are reported in the log, and this function returns true on success.
+/// Statistics about the decision trees of match expressions are printed on request.
 std::tuple<Ptr<ast::ModDecl>, bool> compile(
     const std::vector<std::string>& file_names,
-    const std::vector<std::string>& file_data,
+    const std::vector<std::string_view>& file_data,
     bool warns_as_errors,
     bool enable_all_warns,
+    bool debug,
+    bool print_match_stats,
     Arena& arena,
     TypeTable& table,
     thorin::World& world,
@@ -1,10 +1,11 @@
 #ifndef ARTIC_LEXER_H
 #define ARTIC_LEXER_H
 
-#include <unordered_map>
 #include <istream>
 #include <string>
+#include <string_view>
 
+#include "artic/arena.h"
 #include "artic/log.h"
 #include "artic/token.h"
 
@@ -31,9 +32,15 @@ namespace utf8 {
 }
 
 /// Generates a stream of tokens for the Parser.
+/// The lexer works directly on a contiguous range of characters in memory.
 class Lexer : public Logger {
 public:
-    Lexer(Log& log, const std::string& filename, std::istream& is);
+    /// Reads the whole stream into an internal buffer, and lexes that buffer.
+    /// The contents of string literals are stored in the given arena.
+    Lexer(Log& log, const std::string& filename, std::istream& is, Arena& arena);
+    /// Lexes the given characters, which must outlive the lexer.
+    /// The contents of string literals are stored in the given arena.
+    Lexer(Log& log, const std::string& filename, std::string_view data, Arena& arena);
 
     Token next();
 
@@ -43,25 +50,37 @@ private:
         size_t  size = 1;
     };
 
+    void start(std::string_view);
     void eat();
+    void eat_utf8();
+    /// Skips the current character and every character before the given position.
+    /// The skipped characters must be ASCII characters that are not new lines.
+    void skip_to(const char*);
     void eat_spaces();
+    void eat_line_comment();
     void eat_comments();
     Literal parse_literal();
 
     void append();
+    void append_to(const char*);
     void append_char();
     bool accept(uint8_t);
 
     uint8_t peek(size_t i = 0) const { return cur_.bytes[i]; }
-    bool eof() const { return stream_.eof(); }
+    bool eof() const { return cur_.size == 0; }
 
-    std::istream& stream_;
+    /// Returns a pointer to the current character in the source.
+    const char* cur_ptr() const { return ptr_ - cur_.size; }
+    std::string_view spelling(const char* begin, const char* end) const { return std::string_view(begin, end - begin); }
+
+    std::string buffer_;
+    Arena& arena_;
+    const char* ptr_;
+    const char* end_;
 
     Loc loc_;
     Utf8Char cur_;
     std::string str_;
-
-    static std::unordered_map<std::string, Token::Tag> keywords;
 };
 
 } // namespace artic
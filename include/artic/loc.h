@@ -3,14 +3,23 @@
 
 #include <string>
 #include <ostream>
-#include <memory>
 #include <cassert>
+#include <cstdint>
 
 namespace artic {
 
+/// Identifier of a source file in the global table of files.
+/// The identifier 0 is reserved for locations that are not part of any file.
+using FileId = uint32_t;
+
+/// Returns the identifier of the file with the given name, adding it to the table if necessary.
+FileId file_id(const std::string&);
+/// Returns the name of the file with the given identifier.
+const std::string& file_name(FileId);
+
 /// Source file location.
 struct Loc {
-    std::shared_ptr<std::string> file;
+    FileId file = 0;
     struct Pos {
         int row, col;
     } begin, end;
@@ -26,13 +35,13 @@ struct Loc {
     bool operator != (const Loc& loc) const { return !(*this == loc); }
 
     Loc() = default;
-    Loc(std::shared_ptr<std::string> file, int row, int col)
+    Loc(FileId file, int row, int col)
         : Loc(file, { row, col })
     {}
-    Loc(std::shared_ptr<std::string> file, const Pos& pos)
+    Loc(FileId file, const Pos& pos)
         : Loc(file, pos, pos)
     {}
-    Loc(std::shared_ptr<std::string> file, const Pos& begin, const Pos& end)
+    Loc(FileId file, const Pos& begin, const Pos& end)
         : file(file)
         , begin(begin)
         , end(end)
@@ -59,7 +68,7 @@ struct Loc {
 };
 
 inline std::ostream& operator << (std::ostream& os, const Loc& loc) {
-    os << *loc.file << "(";
+    os << file_name(loc.file) << "(";
     os << loc.begin.row << ", " << loc.begin.col;
     if (loc.begin.row != loc.end.row ||
         loc.begin.col != loc.end.col) {
@@ -44,6 +44,17 @@ struct LocatorInfo {
         return size;
     }
 
+    /// Returns the number of columns needed to display the given part of a line,
+    /// where the TAB character is expanded to the given number of spaces.
+    size_t width(const char* begin, const char* end, size_t tab_width) const {
+        size_t width = 0;
+        while (begin < end) {
+            width += *begin == '\t' ? tab_width : 1;
+            begin = eat(begin);
+        }
+        return width;
+    }
+
     bool covers(const Loc& loc) const {
         return
             size_t(loc.end.row) < lines.size() &&
@@ -86,18 +97,21 @@ public:
         : cur(info.end())
     {}
 
-    const LocatorInfo* data(const std::string& file) {
+    /// Width of the TAB character (in spaces) when displaying source lines.
+    size_t tab_width = 2;
+
+    const LocatorInfo* data(FileId file) {
         auto it = info.find(file);
         return it != info.end() ? &it->second : nullptr;
     }
 
     void register_file(const std::string& file, std::string_view data) {
-        std::tie(cur, std::ignore) = info.emplace(file, data);
+        std::tie(cur, std::ignore) = info.emplace(file_id(file), data);
     }
 
 private:
-    std::unordered_map<std::string, LocatorInfo> info;
-    std::unordered_map<std::string, LocatorInfo>::iterator cur;
+    std::unordered_map<FileId, LocatorInfo> info;
+    std::unordered_map<FileId, LocatorInfo>::iterator cur;
 };
 
 } // namespace artic
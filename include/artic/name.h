@@ -0,0 +1,62 @@
+#ifndef ARTIC_NAME_H
+#define ARTIC_NAME_H
+
+#include <string>
+#include <string_view>
+#include <ostream>
+#include <functional>
+
+namespace artic {
+
+/// Handle to a string stored in the name pool of the current thread. Strings are stored
+/// only once in the pool (they are interned), which means that two handles are equal
+/// if and only if they refer to the same string. Handles can thus be compared and
+/// hashed in constant time. Since each thread has its own pool, interning requires no
+/// locking, but handles created by different threads must not be mixed. The strings in
+/// the pool live until the end of the thread that created them.
+class Name {
+public:
+    /// Creates a handle to the empty string.
+    Name() : entry_(&empty_entry()) {}
+    /// Creates a handle to the given string, adding it to the pool if necessary.
+    explicit Name(std::string_view);
+
+    const std::string& str() const { return entry_->str; }
+    operator const std::string& () const { return entry_->str; }
+
+    bool empty() const { return entry_->str.empty(); }
+
+    /// Returns the hash of the string, which is computed only once, when it is added to the pool.
+    /// This is the same value as the one given by `std::hash<std::string>`.
+    size_t hash() const { return entry_->hash; }
+
+    bool operator == (const Name& other) const { return entry_ == other.entry_; }
+    bool operator != (const Name& other) const { return entry_ != other.entry_; }
+    bool operator == (std::string_view other) const { return entry_->str == other; }
+    bool operator != (std::string_view other) const { return entry_->str != other; }
+
+    struct Entry {
+        std::string str;
+        size_t hash;
+    };
+
+private:
+    static const Entry& empty_entry();
+
+    const Entry* entry_;
+};
+
+inline std::ostream& operator << (std::ostream& os, const Name& name) {
+    return os << name.str();
+}
+
+} // namespace artic
+
+template <>
+struct std::hash<artic::Name> {
+    size_t operator () (const artic::Name& name) const {
+        return name.hash();
+    }
+};
+
+#endif // ARTIC_NAME_H
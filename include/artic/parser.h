@@ -157,7 +157,9 @@ private:
             if (it == tags.end()) {
                 std::string tag_list;
                 for (size_t i = 0; i < N; i++) {
-                    tag_list += '\'' + Token::tag_to_string(tags[i]) + '\'';
+                    tag_list += '\'';
+                    tag_list += Token::tag_to_string(tags[i]);
+                    tag_list += '\'';
                     if (i != N - 1) tag_list += " or ";
                 }
                 error(ahead().loc(), "expected {}, got '{}'", tag_list, ahead().string());
@@ -194,7 +196,7 @@ private:
     void next() {
         prev_ = ahead_[0].loc();
         for (int i = 0; i < max_ahead - 1; i++)
-            ahead_[i] = ahead_[i + 1];
+            ahead_[i] = std::move(ahead_[i + 1]);
         ahead_[max_ahead - 1] = lexer_.next();
     }
 
@@ -0,0 +1,118 @@
+#ifndef ARTIC_SCOPED_MAP_H
+#define ARTIC_SCOPED_MAP_H
+
+#include <cassert>
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace artic {
+
+/// Associative container organized as a stack of scopes. Bindings are stored in a single
+/// stack, in insertion order, and every binding links to the binding it shadows. An index
+/// maps each key to its innermost binding, so that a lookup is a single probe, regardless
+/// of the nesting depth. Each scope only records where its bindings start in the stack,
+/// which acts as an undo log: leaving a scope restores the index entries of the bindings
+/// it introduced.
+template <typename K, typename V, typename Index = std::unordered_map<K, size_t>>
+class ScopedMap {
+public:
+    struct Binding {
+        K key;
+        V value;
+        /// Index of the binding shadowed by this one, if any.
+        size_t shadowed;
+        /// Index of the scope containing this binding.
+        size_t scope;
+        bool erased = false;
+
+        Binding(const K& key, V&& value, size_t shadowed, size_t scope)
+            : key(key), value(std::move(value)), shadowed(shadowed), scope(scope)
+        {}
+    };
+
+    static constexpr size_t none = size_t(-1);
+
+    size_t depth() const { return scopes_.size(); }
+
+    /// Returns the bindings of the given scope, in insertion order.
+    /// Erased bindings are included, and must be skipped by the caller.
+    std::pair<const Binding*, const Binding*> bindings(size_t i) const {
+        return std::make_pair(bindings_.data() + scopes_[i], bindings_.data() + scope_end(i));
+    }
+
+    std::pair<Binding*, Binding*> bindings(size_t i) {
+        return std::make_pair(bindings_.data() + scopes_[i], bindings_.data() + scope_end(i));
+    }
+
+    void push_scope() {
+        scopes_.push_back(bindings_.size());
+    }
+
+    void pop_scope() {
+        assert(!scopes_.empty());
+        auto begin = scopes_.back();
+        while (bindings_.size() > begin) {
+            auto& binding = bindings_.back();
+            if (!binding.erased)
+                restore(binding);
+            bindings_.pop_back();
+        }
+        scopes_.pop_back();
+    }
+
+    /// Finds the value of the innermost binding for the given key.
+    /// The returned pointer is invalidated by insertions.
+    V* find(const K& key) {
+        auto it = index_.find(key);
+        return it != index_.end() ? &bindings_[it->second].value : nullptr;
+    }
+
+    /// Removes the innermost binding for the given key.
+    void erase(const K& key) {
+        auto it = index_.find(key);
+        if (it == index_.end())
+            return;
+        auto& binding = bindings_[it->second];
+        binding.erased = true;
+        restore(binding);
+    }
+
+    /// Inserts a binding in the innermost scope. Returns false if
+    /// that scope already contains a binding with the same key.
+    bool insert(const K& key, V value) {
+        assert(!scopes_.empty());
+        auto [it, inserted] = index_.emplace(key, bindings_.size());
+        auto shadowed = none;
+        if (!inserted) {
+            if (bindings_[it->second].scope == scopes_.size() - 1)
+                return false;
+            shadowed = std::exchange(it->second, bindings_.size());
+        }
+        bindings_.emplace_back(key, std::move(value), shadowed, scopes_.size() - 1);
+        return true;
+    }
+
+private:
+    size_t scope_end(size_t i) const {
+        return i + 1 < scopes_.size() ? scopes_[i + 1] : bindings_.size();
+    }
+
+    /// Makes the binding shadowed by the given one visible again.
+    void restore(const Binding& binding) {
+        if (binding.shadowed != none)
+            index_[binding.key] = binding.shadowed;
+        else
+            index_.erase(binding.key);
+    }
+
+    std::vector<Binding> bindings_;
+    /// Index of the first binding of each scope, from outermost to innermost.
+    std::vector<size_t> scopes_;
+    Index index_;
+};
+
+} // namespace artic
+
+#endif // ARTIC_SCOPED_MAP_H
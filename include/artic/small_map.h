@@ -0,0 +1,137 @@
+#ifndef ARTIC_SMALL_MAP_H
+#define ARTIC_SMALL_MAP_H
+
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace artic {
+
+/// Flat associative container for maps that usually hold only a handful of entries.
+/// Up to `N` entries are stored inline, in insertion order, and are looked up with a
+/// linear scan. Larger maps move their entries to the heap, where they are kept sorted
+/// by key and looked up with a binary search. Iterators are invalidated by insertions.
+template <typename K, typename V, size_t N = 4, typename Less = std::less<K>>
+class SmallMap {
+public:
+    using key_type       = K;
+    using mapped_type    = V;
+    using value_type     = std::pair<K, V>;
+    using iterator       = value_type*;
+    using const_iterator = const value_type*;
+
+    SmallMap() = default;
+
+    template <typename It>
+    SmallMap(It begin, It end) { insert(begin, end); }
+
+    SmallMap(std::initializer_list<value_type> l)
+        : SmallMap(l.begin(), l.end())
+    {}
+
+    SmallMap(const SmallMap&) = default;
+    SmallMap& operator = (const SmallMap&) = default;
+
+    /// Moved-from maps are left empty, so that they can safely be reused.
+    SmallMap(SmallMap&& other) { *this = std::move(other); }
+
+    SmallMap& operator = (SmallMap&& other) {
+        if (this != &other) {
+            std::move(other.inline_, other.inline_ + (other.is_inline() ? other.size_ : 0), inline_);
+            heap_ = std::move(other.heap_);
+            size_ = other.size_;
+            other.clear();
+        }
+        return *this;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + size_; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size_; }
+
+    iterator find(const K& key) {
+        return const_cast<iterator>(static_cast<const SmallMap*>(this)->find(key));
+    }
+
+    const_iterator find(const K& key) const {
+        if (is_inline()) {
+            for (auto it = begin(); it != end(); ++it) {
+                if (it->first == key)
+                    return it;
+            }
+            return end();
+        }
+        auto it = lower_bound(key);
+        return it != end() && it->first == key ? it : end();
+    }
+
+    size_t count(const K& key) const { return find(key) != end() ? 1 : 0; }
+
+    /// Inserts the given entry if its key is not already present.
+    /// Returns the position of the entry for that key, and whether an insertion took place.
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(const K& key, Args&&... args) {
+        if (auto it = find(key); it != end())
+            return std::make_pair(it, false);
+        if (is_inline() && size_ < N) {
+            inline_[size_] = value_type(key, V(std::forward<Args>(args)...));
+            return std::make_pair(inline_ + size_++, true);
+        }
+        if (is_inline()) {
+            heap_.assign(
+                std::make_move_iterator(inline_),
+                std::make_move_iterator(inline_ + size_));
+            std::sort(heap_.begin(), heap_.end(),
+                [] (const value_type& a, const value_type& b) { return Less()(a.first, b.first); });
+        }
+        auto pos = lower_bound(key) - heap_.data();
+        heap_.emplace(heap_.begin() + pos, key, V(std::forward<Args>(args)...));
+        size_++;
+        return std::make_pair(heap_.data() + pos, true);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return emplace(value.first, value.second);
+    }
+
+    /// Inserts the entries of the given range whose keys are not already present.
+    template <typename It>
+    void insert(It begin, It end) {
+        for (; begin != end; ++begin)
+            emplace(begin->first, begin->second);
+    }
+
+    V& operator [] (const K& key) { return emplace(key).first->second; }
+
+    void clear() {
+        heap_.clear();
+        std::fill(inline_, inline_ + N, value_type());
+        size_ = 0;
+    }
+
+private:
+    bool is_inline() const { return heap_.empty(); }
+
+    value_type* data() { return is_inline() ? inline_ : heap_.data(); }
+    const value_type* data() const { return is_inline() ? inline_ : heap_.data(); }
+
+    const_iterator lower_bound(const K& key) const {
+        return std::lower_bound(begin(), end(), key,
+            [] (const value_type& a, const K& b) { return Less()(a.first, b); });
+    }
+
+    value_type inline_[N] = {};
+    std::vector<value_type> heap_;
+    size_t size_ = 0;
+};
+
+} // namespace artic
+
+#endif // ARTIC_SMALL_MAP_H
@@ -0,0 +1,42 @@
+#ifndef ARTIC_SOURCE_H
+#define ARTIC_SOURCE_H
+
+#include <string>
+#include <string_view>
+#include <optional>
+
+namespace artic {
+
+/// Read-only view of the contents of a source file. Regular files are mapped
+/// into memory, so that the lexer, the locator, and the diagnostics can all
+/// refer to the same bytes without copying them. Other files (pipes, or
+/// platforms without memory mapping) are read into an owned buffer instead.
+class SourceFile {
+public:
+    SourceFile(SourceFile&&);
+    SourceFile(const SourceFile&) = delete;
+    ~SourceFile();
+
+    SourceFile& operator = (SourceFile&&);
+    SourceFile& operator = (const SourceFile&) = delete;
+
+    /// Opens the given file, or returns nothing if it cannot be read.
+    static std::optional<SourceFile> open(const std::string&);
+
+    std::string_view data() const {
+        return map_ ? std::string_view(static_cast<const char*>(map_), map_size_) : std::string_view(buffer_);
+    }
+
+private:
+    SourceFile() = default;
+
+    void unmap();
+
+    void* map_ = nullptr;
+    size_t map_size_ = 0;
+    std::string buffer_;
+};
+
+} // namespace artic
+
+#endif // ARTIC_SOURCE_H
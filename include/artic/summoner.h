@@ -6,6 +6,7 @@
 #include "artic/ast.h"
 #include "artic/types.h"
 #include "artic/log.h"
+#include "artic/scoped_map.h"
 
 namespace artic {
 
@@ -26,7 +27,8 @@ private:
     const ast::Expr* resolve(const artic::Type*, const artic::Loc& at);
 
     bool error = false;
-    std::vector<TypeMap<const ast::Expr*>> scopes;
+    /// Implicit values available for each type.
+    ScopedMap<const artic::Type*, const ast::Expr*> implicits;
 
     Arena& _arena;
 
@@ -3,10 +3,15 @@
 
 #include <unordered_map>
 #include <type_traits>
+#include <cassert>
+#include <utility>
 #include <memory>
 #include <vector>
 #include <string>
 
+#include "artic/name.h"
+#include "artic/scoped_map.h"
+
 namespace artic {
 
 namespace ast {
@@ -22,40 +27,41 @@ struct Symbol {
     {}
 };
 
-/// Table containing a map from symbol name to declaration site.
-struct SymbolTable {
-    bool top_level;
-    std::unordered_map<std::string, Symbol> symbols;
-
-    SymbolTable(bool top_level = false)
-        : top_level(top_level)
-    {}
+/// Table of the symbols visible at a given point of the program, organized as a stack of scopes.
+class SymbolTable : public ScopedMap<Name, Symbol> {
+public:
+    bool is_top_level(size_t i) const { return top_level_[i]; }
 
-    Symbol* find(const std::string& name) {
-        auto it = symbols.find(name);
-        return it != symbols.end() ? &it->second : nullptr;
+    void push_scope(bool top_level) {
+        ScopedMap::push_scope();
+        top_level_.push_back(top_level);
     }
 
-    void erase(const std::string& name) {
-        symbols.erase(name);
+    void pop_scope() {
+        ScopedMap::pop_scope();
+        top_level_.pop_back();
     }
 
+    /// Finds the symbol of the given scope whose name is the closest to the given one,
+    /// provided that its distance is lower than `min`, which is then updated.
     template <typename T, typename DistanceFn>
-    Symbol* find_similar(const std::string& name, T& min, DistanceFn distance) {
+    Symbol* find_similar(size_t i, Name name, T& min, DistanceFn distance) {
         Symbol* best = nullptr;
-        for (auto& symbol : symbols) {
-            auto d = distance(symbol.first, name, min);
+        auto [begin, end] = bindings(i);
+        for (auto binding = begin; binding != end; ++binding) {
+            if (binding->erased)
+                continue;
+            auto d = distance(binding->key.str(), name.str(), min);
             if (d < min) {
-                best = &symbol.second;
+                best = &binding->value;
                 min  = d;
             }
         }
         return best;
     }
 
-    bool insert(const std::string& name, Symbol&& symbol) {
-        return symbols.emplace(name, std::move(symbol)).second;
-    }
+private:
+    std::vector<bool> top_level_;
 };
 
 } // namespace artic
@@ -2,11 +2,13 @@
 #define ARTIC_TOKEN_H
 
 #include <string>
+#include <string_view>
 #include <ostream>
 #include <cassert>
 #include <cstdint>
 
 #include "artic/loc.h"
+#include "artic/name.h"
 
 namespace artic {
 
@@ -99,13 +101,19 @@ struct Literal {
         Integer,
         Bool
     };
+    /// Characters of a string literal, which are stored in the arena of the AST.
+    struct Chars {
+        const char* data;
+        size_t size;
+    };
+
     Tag tag;
-    std::string string;
     union {
         uint8_t  char_;
         bool     bool_;
         double   double_;
         uint64_t integer;
+        Chars    chars;
     };
 
     bool is_double()  const { return tag == Double;  }
@@ -119,14 +127,14 @@ struct Literal {
     bool     as_bool()    const { assert(is_bool());    return bool_;   }
     uint8_t  as_char()    const { assert(is_char());    return char_;   }
 
-    const std::string& as_string() const { assert(is_string());  return string;  }
+    std::string_view as_string() const { assert(is_string()); return std::string_view(chars.data, chars.size); }
 
     Literal() = default;
     Literal(uint64_t i)    : tag(Integer), integer(i) {}
     Literal(double d)      : tag(Double),  double_(d) {}
     Literal(bool b)        : tag(Bool),    bool_(b)   {}
     Literal(uint8_t c)     : tag(Char),    char_(c)   {}
-    Literal(std::string s) : tag(String),  string(s)  {}
+    Literal(std::string_view s) : tag(String), chars { s.data(), s.size() } {}
 };
 
 inline std::ostream& operator << (std::ostream& os, const Literal& lit) {
@@ -161,9 +169,13 @@ inline std::ostream& operator << (std::ostream& os, const Literal& lit) {
     }
 }
 
+/// Token produced by the Lexer. Tokens do not own their spelling: Identifiers hold a
+/// handle to the name pool, regular tokens use a constant string that depends on their
+/// tag, and literals refer to their spelling in the source file. Since a token is either
+/// a literal or an identifier, both share the same storage.
 struct Token {
 public:
-    enum Tag {
+    enum Tag : uint8_t {
 #define TAG(t, str) t,
         TOKEN_TAGS(TAG)
 #undef TAG
@@ -174,53 +186,60 @@ public:
         : Token(loc, Error)
     {}
 
-    /// Constructor for regular tokens, taking a string (e.g. for error messages)
-    Token(const Loc& loc, Tag tag, const std::string& str)
-        : loc_(loc), tag_(tag), str_(str)
-    {}
     /// Constructor for regular tokens
     Token(const Loc& loc, Tag tag)
-        : Token(loc, tag, tag_to_string(tag))
+        : loc_(loc), tag_(tag), lit_()
     {}
 
-    /// Constructor for literal tokens
-    Token(const Loc& loc, const std::string& str, const Literal& lit)
+    /// Constructor for literal tokens, taking the spelling of the literal in the source file
+    Token(const Loc& loc, std::string_view str, const Literal& lit)
         : loc_(loc), tag_(Lit), lit_(lit), str_(str)
     {}
 
     /// Constructor for identifiers
-    Token(const Loc& loc, const std::string& str)
-        : loc_(loc), tag_(Id), str_(str)
+    Token(const Loc& loc, Name name)
+        : loc_(loc), tag_(Id), name_(name)
     {}
 
     Tag tag() const { return tag_; }
     const Literal& literal() const { assert(is_literal()); return lit_; }
-    const std::string& identifier() const { assert(is_identifier()); return str_; }
-    const std::string& string() const { return str_; }
+    Name identifier() const { assert(is_identifier()); return name_; }
+
+    /// Returns the spelling of the token, which is only needed for diagnostics.
+    std::string_view string() const {
+        switch (tag_) {
+            case Id:  return name_.str();
+            case Lit: return str_;
+            default:  return tag_to_string(tag_);
+        }
+    }
 
     bool is_identifier() const { return tag_ == Id; }
     bool is_literal() const { return tag_ == Lit; }
 
     const Loc& loc() const { return loc_; }
 
-    bool operator == (const Token& token) const { return token.loc_ == loc_ && token.str_ == str_; }
-    bool operator != (const Token& token) const { return token.loc_ != loc_ || token.str_ != str_; }
+    bool operator == (const Token& token) const { return token.loc_ == loc_ && token.tag_ == tag_ && token.string() == string(); }
+    bool operator != (const Token& token) const { return !(*this == token); }
 
-    static std::string tag_to_string(Tag tag) {
+    static constexpr std::string_view tag_to_string(Tag tag) {
         switch (tag) {
 #define TAG(t, str) case t: return str;
             TOKEN_TAGS(TAG)
 #undef TAG
             default: assert(false);
         }
-        return std::string();
+        return std::string_view();
     }
 
 private:
     Loc loc_;
     Tag tag_;
-    Literal lit_ = Literal();
-    std::string str_;
+    union {
+        Literal lit_;
+        Name name_;
+    };
+    std::string_view str_;
 };
 
 } // namespace artic
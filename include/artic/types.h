@@ -11,6 +11,7 @@
 #include "artic/ast.h"
 #include "artic/array.h"
 #include "artic/hash.h"
+#include "artic/small_map.h"
 
 namespace thorin {
 
@@ -27,7 +28,8 @@ class Emitter;
 struct TypeVar;
 
 template <typename T> using TypeMap = std::unordered_map<const Type*, T>;
-template <typename T> using TypeVarMap = std::unordered_map<const TypeVar*, T>;
+/// Maps from type variables hold very few entries in practice (one per type parameter).
+template <typename T> using TypeVarMap = SmallMap<const TypeVar*, T>;
 using ReplaceMap = TypeVarMap<const Type*>;
 
 /// Variance for a type variable appearing in a type. It represents the
@@ -48,22 +50,51 @@ struct TypeBounds {
     TypeBounds& meet(const TypeBounds&);
 };
 
+/// Kind of a type, with one value per concrete type class.
+/// The kinds of the classes that share a base class are contiguous.
+enum class TypeKind : uint8_t {
+    Prim,
+    Tuple,
+    SizedArray,
+    UnsizedArray,
+    Ptr,
+    Ref,
+    ImplicitParam,
+    Fn,
+    Bottom,
+    NoRet,
+    Top,
+    Error,
+    Var,
+    Forall,
+    Struct,
+    Enum,
+    Mod,
+    Alias,
+    App
+};
+
 /// Base class for all types. Types should be created by a `TypeTable`,
 /// which will hash them and place them into a set. This makes types
 /// comparable via pointer equality, as long as they were created with
-/// the same `TypeTable` object.
+/// the same `TypeTable` object. Types are allocated in an arena owned
+/// by the `TypeTable`, and must not be deleted.
+///
+/// Each concrete type class provides two non-virtual functions, which are
+/// used by the `TypeTable` to find existing types: `compute_hash()`, and
+/// `equals()`, which is only called on types of the same kind.
 struct Type : public Cast<Type> {
     TypeTable& type_table;
+    TypeKind kind;
 
-    Type(TypeTable& type_table)
-        : type_table(type_table)
+    Type(TypeTable& type_table, TypeKind kind)
+        : type_table(type_table), kind(kind)
     {}
 
-    virtual ~Type() {}
+    /// Returns the hash of this type, computed when it was added to the type table.
+    size_t hash() const { return hash_; }
 
     virtual void print(Printer&) const = 0;
-    virtual bool equals(const Type*) const = 0;
-    virtual size_t hash() const = 0;
     virtual bool contains(const Type* type) const { return this == type; }
     virtual const Type* replace(const ReplaceMap&) const { return this; }
 
@@ -79,17 +110,18 @@ struct Type : public Cast<Type> {
     virtual bool is_sized(std::unordered_set<const Type*>&) const;
 
     /// Returns the number of times a function type constructor is present in the type.
+    /// The result is computed once, and then cached in the type.
     size_t order() const {
-        std::unordered_set<const Type*> seen;
-        return order(seen);
+        if (!order_) {
+            std::unordered_set<const Type*> seen;
+            order_ = order(seen);
+        }
+        return *order_;
     }
 
     /// Computes the variance of the set of type variables that appear in this type.
-    TypeVarMap<TypeVariance> variance(bool dir = true) const {
-        TypeVarMap<TypeVariance> vars;
-        variance(vars, dir);
-        return vars;
-    }
+    /// The result is cached in the type table.
+    const TypeVarMap<TypeVariance>& variance(bool dir = true) const;
 
     /// Computes the bounds of the type variables that appear in this type.
     TypeVarMap<TypeBounds> bounds(const Type* arg, bool dir = true) const {
@@ -99,19 +131,38 @@ struct Type : public Cast<Type> {
     }
 
     /// Returns whether this type can be represented in memory or not.
+    /// The result is computed once, and then cached in the type.
     bool is_sized() const {
-        std::unordered_set<const Type*> seen;
-        return is_sized(seen);
+        if (!is_sized_) {
+            std::unordered_set<const Type*> seen;
+            is_sized_ = is_sized(seen);
+        }
+        return *is_sized_;
     }
 
     /// Returns true if this type is a sub-type of another.
+    /// The result is cached in the type table.
     bool subtype(const Type*) const;
 
     /// Returns the least upper bound between this type and another.
+    /// The result is cached in the type table.
     const Type* join(const Type*) const;
 
     /// Prints the type on the console, for debugging.
     void dump() const;
+
+private:
+    bool compute_subtype(const Type*) const;
+
+    size_t hash_ = 0;
+
+    // Only the results for the type on which the computation started are cached: When
+    // recursive structures or enumerations are involved, the intermediate results depend
+    // on the types that have been visited already.
+    mutable std::optional<size_t> order_;
+    mutable std::optional<bool> is_sized_;
+
+    friend class TypeTable;
 };
 
 /// The type of an attribute.
@@ -127,26 +178,29 @@ struct PrimType : public Type {
     ast::PrimType::Tag tag;
 
     void print(Printer&) const override;
-    bool equals(const Type*) const override;
-    size_t hash() const override;
+    bool equals(const Type*) const;
+    size_t compute_hash() const;
 
     const thorin::Type* convert(Emitter&) const override;
     std::string stringify(Emitter&) const override;
 
+    using ClassOf = PrimType;
+    static bool classof(const Type* type) { return type->kind == TypeKind::Prim; }
+
 private:
     PrimType(TypeTable& type_table, ast::PrimType::Tag tag)
-        : Type(type_table), tag(tag)
+        : Type(type_table, TypeKind::Prim), tag(tag)
     {}
 
     friend class TypeTable;
 };
 
 struct TupleType : public Type {
-    Array<const Type*> args;
+    ArrayRef<const Type*> args;
 
     void print(Printer&) const override;
-    bool equals(const Type*) const override;
-    size_t hash() const override;
+    bool equals(const Type*) const;
+    size_t compute_hash() const;
     bool contains(const Type*) const override;
     const Type* replace(const ReplaceMap&) const override;
 
@@ -158,9 +212,12 @@ struct TupleType : public Type {
     void bounds(TypeVarMap<TypeBounds>&, const Type*, bool) const override;
     bool is_sized(std::unordered_set<const Type*>&) const override;
 
+    using ClassOf = TupleType;
+    static bool classof(const Type* type) { return type->kind == TypeKind::Tuple; }
+
 private:
     TupleType(TypeTable& type_table, const ArrayRef<const Type*>& args)
-        : Type(type_table), args(args)
+        : Type(type_table, TypeKind::Tuple), args(args)
     {}
 
     friend class TypeTable;
@@ -170,8 +227,8 @@ private:
 struct ArrayType : public Type {
     const Type* elem;
 
-    ArrayType(TypeTable& type_table, const Type* elem)
-        : Type(type_table), elem(elem)
+    ArrayType(TypeTable& type_table, TypeKind kind, const Type* elem)
+        : Type(type_table, kind), elem(elem)
     {}
 
     bool contains(const Type*) const override;
@@ -180,6 +237,11 @@ struct ArrayType : public Type {
     void variance(TypeVarMap<TypeVariance>&, bool) const override;
     void bounds(TypeVarMap<TypeBounds>&, const Type*, bool) const override;
     bool is_sized(std::unordered_set<const Type*>&) const override;
+
+    using ClassOf = ArrayType;
+    static bool classof(const Type* type) {
+        return type->kind >= TypeKind::SizedArray && type->kind <= TypeKind::UnsizedArray;
+    }
 };
 
 /// An array whose size is known at compile-time.
@@ -188,17 +250,20 @@ struct SizedArrayType : public ArrayType {
     bool is_simd;
 
     void print(Printer&) const override;
-    bool equals(const Type*) const override;
-    size_t hash() const override;
+    bool equals(const Type*) const;
+    size_t compute_hash() const;
 
     const Type* replace(const ReplaceMap&) const override;
 
     const thorin::Type* convert(Emitter&) const override;
     std::string stringify(Emitter&) const override;
 
+    using ClassOf = SizedArrayType;
+    static bool classof(const Type* type) { return type->kind == TypeKind::SizedArray; }
+
 private:
     SizedArrayType(TypeTable& type_table, const Type* elem, size_t size, bool is_simd)
-        : ArrayType(type_table, elem), size(size), is_simd(is_simd)
+        : ArrayType(type_table, TypeKind::SizedArray, elem), size(size), is_simd(is_simd)
     {}
 
     friend class TypeTable;
@@ -207,17 +272,20 @@ private:
 /// An array whose size is not known at compile-time.
 struct UnsizedArrayType : public ArrayType {
     void print(Printer&) const override;
-    bool equals(const Type*) const override;
-    size_t hash() const override;
+    bool equals(const Type*) const;
+    size_t compute_hash() const;
 
     const Type* replace(const ReplaceMap&) const override;
 
     const thorin::Type* convert(Emitter&) const override;
     std::string stringify(Emitter&) const override;
 
+    using ClassOf = UnsizedArrayType;
+    static bool classof(const Type* type) { return type->kind == TypeKind::UnsizedArray; }
+
 private:
     UnsizedArrayType(TypeTable& type_table, const Type* elem)
-        : ArrayType(type_table, elem)
+        : ArrayType(type_table, TypeKind::UnsizedArray, elem)
     {}
 
     friend class TypeTable;
@@ -229,12 +297,12 @@ struct AddrType : public Type {
     bool is_mut;
     size_t addr_space;
 
-    AddrType(TypeTable& type_table, const Type* pointee, bool is_mut, size_t addr_space)
-        : Type(type_table), pointee(pointee), is_mut(is_mut), addr_space(addr_space)
+    AddrType(TypeTable& type_table, TypeKind kind, const Type* pointee, bool is_mut, size_t addr_space)
+        : Type(type_table, kind), pointee(pointee), is_mut(is_mut), addr_space(addr_space)
     {}
 
-    bool equals(const Type*) const override;
-    size_t hash() const override;
+    bool equals(const Type*) const;
+    size_t compute_hash() const;
     bool contains(const Type*) const override;
 
     bool is_compatible_with(const AddrType* other) const;
@@ -243,6 +311,11 @@ struct AddrType : public Type {
     void variance(TypeVarMap<TypeVariance>&, bool) const override;
     void bounds(TypeVarMap<TypeBounds>&, const Type*, bool) const override;
     bool is_sized(std::unordered_set<const Type*>&) const override;
+
+    using ClassOf = AddrType;
+    static bool classof(const Type* type) {
+        return type->kind >= TypeKind::Ptr && type->kind <= TypeKind::Ref;
+    }
 };
 
 /// A pointer type, as the result of taking the address of an object.
@@ -254,9 +327,12 @@ struct PtrType : public AddrType {
     const thorin::Type* convert(Emitter&) const override;
     std::string stringify(Emitter&) const override;
 
+    using ClassOf = PtrType;
+    static bool classof(const Type* type) { return type->kind == TypeKind::Ptr; }
+
 private:
     PtrType(TypeTable& type_table, const Type* pointee, bool is_mut, size_t addr_space)
-        : AddrType(type_table, pointee, is_mut, addr_space)
+        : AddrType(type_table, TypeKind::Ptr, pointee, is_mut, addr_space)
     {}
 
     friend class TypeTable;
@@ -267,9 +343,12 @@ struct RefType : public AddrType {
     void print(Printer&) const override;
     const Type* replace(const ReplaceMap&) const override;
 
+    using ClassOf = RefType;
+    static bool classof(const Type* type) { return type->kind == TypeKind::Ref; }
+
 private:
     RefType(TypeTable& type_table, const Type* pointee, bool is_mut, size_t addr_space)
-        : AddrType(type_table, pointee, is_mut, addr_space)
+        : AddrType(type_table, TypeKind::Ref, pointee, is_mut, addr_space)
     {}
 
     friend class TypeTable;
@@ -279,8 +358,8 @@ struct ImplicitParamType : public Type {
     const Type* underlying;
 
     void print(Printer&) const override;
-    bool equals(const Type*) const override;
-    size_t hash() const override;
+    bool equals(const Type*) const;
+    size_t compute_hash() const;
     bool contains(const Type*) const override;
 
     const Type* replace(const ReplaceMap&) const override;
@@ -292,9 +371,13 @@ struct ImplicitParamType : public Type {
     void variance(TypeVarMap<TypeVariance>&, bool) const override;
     void bounds(TypeVarMap<TypeBounds>&, const Type*, bool) const override;
     bool is_sized(std::unordered_set<const Type*>&) const override;
+
+    using ClassOf = ImplicitParamType;
+    static bool classof(const Type* type) { return type->kind == TypeKind::ImplicitParam; }
+
 private:
     ImplicitParamType(TypeTable& type_table, const Type* underlying)
-        : Type(type_table)
+        : Type(type_table, TypeKind::ImplicitParam)
         , underlying(underlying)
     {}
 
@@ -307,8 +390,8 @@ struct FnType : public Type {
     const Type* codom;
 
     void print(Printer&) const override;
-    bool equals(const Type*) const override;
-    size_t hash() const override;
+    bool equals(const Type*) const;
+    size_t compute_hash() const;
     bool contains(const Type*) const override;
 
     const Type* replace(const ReplaceMap&) const override;
@@ -321,9 +404,12 @@ struct FnType : public Type {
     void bounds(TypeVarMap<TypeBounds>&, const Type*, bool) const override;
     bool is_sized(std::unordered_set<const Type*>&) const override;
 
+    using ClassOf = FnType;
+    static bool classof(const Type* type) { return type->kind == TypeKind::Fn; }
+
 private:
     FnType(TypeTable& type_table, const Type* dom, const Type* codom)
-        : Type(type_table), dom(dom), codom(codom)
+        : Type(type_table, TypeKind::Fn), dom(dom), codom(codom)
     {}
 
     friend class TypeTable;
@@ -332,12 +418,17 @@ private:
 /// Bottom type: Subtype of any other type
 struct BottomType : public Type {
     void print(Printer&) const override;
-    bool equals(const Type*) const override;
-    size_t hash() const override;
+    bool equals(const Type*) const;
+    size_t compute_hash() const;
+
+    using ClassOf = BottomType;
+    static bool classof(const Type* type) {
+        return type->kind >= TypeKind::Bottom && type->kind <= TypeKind::NoRet;
+    }
 
 protected:
-    BottomType(TypeTable& type_table)
-        : Type(type_table)
+    BottomType(TypeTable& type_table, TypeKind kind = TypeKind::Bottom)
+        : Type(type_table, kind)
     {}
 
     friend class TypeTable;
@@ -346,12 +437,17 @@ protected:
 /// Top type: Supertype of any other type
 struct TopType : public Type {
     void print(Printer&) const override;
-    bool equals(const Type*) const override;
-    size_t hash() const override;
+    bool equals(const Type*) const;
+    size_t compute_hash() const;
+
+    using ClassOf = TopType;
+    static bool classof(const Type* type) {
+        return type->kind >= TypeKind::Top && type->kind <= TypeKind::Error;
+    }
 
 protected:
-    TopType(TypeTable& type_table)
-        : Type(type_table)
+    TopType(TypeTable& type_table, TypeKind kind = TypeKind::Top)
+        : Type(type_table, kind)
     {}
 
     friend class TypeTable;
@@ -364,9 +460,12 @@ struct NoRetType : public BottomType {
     const thorin::Type* convert(Emitter&) const override;
     std::string stringify(Emitter&) const override;
 
+    using ClassOf = NoRetType;
+    static bool classof(const Type* type) { return type->kind == TypeKind::NoRet; }
+
 private:
     NoRetType(TypeTable& type_table)
-        : BottomType(type_table)
+        : BottomType(type_table, TypeKind::NoRet)
     {}
 
     friend class TypeTable;
@@ -376,9 +475,12 @@ private:
 struct TypeError : public TopType {
     void print(Printer&) const override;
 
+    using ClassOf = TypeError;
+    static bool classof(const Type* type) { return type->kind == TypeKind::Error; }
+
 private:
     TypeError(TypeTable& type_table)
-        : TopType(type_table)
+        : TopType(type_table, TypeKind::Error)
     {}
 
     friend class TypeTable;
@@ -389,17 +491,17 @@ template <typename Super, typename Decl>
 struct TypeFromDecl : public Super {
     const Decl& decl;
 
-    size_t hash() const override {
-        return fnv::Hash().combine(&decl);
+    size_t compute_hash() const {
+        return fnv::Hash().combine(this->kind).combine(&decl);
     }
 
-    bool equals(const Type* other) const override {
-        return other->isa<TypeFromDecl>() && &other->as<TypeFromDecl>()->decl == &decl;
+    bool equals(const Type* other) const {
+        return &static_cast<const TypeFromDecl*>(other)->decl == &decl;
     }
 
 protected:
-    TypeFromDecl(TypeTable& type_table, const Decl& decl)
-        : Super(type_table), decl(decl)
+    TypeFromDecl(TypeTable& type_table, TypeKind kind, const Decl& decl)
+        : Super(type_table, kind), decl(decl)
     {}
 };
 
@@ -415,9 +517,12 @@ struct TypeVar : public TypeFromDecl<Type, ast::TypeParam> {
     void variance(TypeVarMap<TypeVariance>&, bool) const override;
     void bounds(TypeVarMap<TypeBounds>&, const Type*, bool) const override;
 
+    using ClassOf = TypeVar;
+    static bool classof(const Type* type) { return type->kind == TypeKind::Var; }
+
 private:
     TypeVar(TypeTable& type_table, const ast::TypeParam& param)
-        : TypeFromDecl(type_table, param)
+        : TypeFromDecl(type_table, TypeKind::Var, param)
     {}
 
     friend class TypeTable;
@@ -425,14 +530,19 @@ private:
 
 /// Base class for types that _may_ be polymorphic.
 struct PolyType : public Type {
-    PolyType(TypeTable& type_table)
-        : Type(type_table)
+    PolyType(TypeTable& type_table, TypeKind kind)
+        : Type(type_table, kind)
     {}
 
     virtual const ast::TypeParamList* type_params() const { return nullptr; }
 
     /// Returns a map from the type parameters of this polymorphic type to the provided arguments.
     ReplaceMap replace_map(const ArrayRef<const Type*>&) const;
+
+    using ClassOf = PolyType;
+    static bool classof(const Type* type) {
+        return type->kind >= TypeKind::Forall && type->kind <= TypeKind::Alias;
+    }
 };
 
 /// Helper mixin to extract the type parameter list from a particular `Decl`.
@@ -441,8 +551,8 @@ struct PolyTypeFromDecl : public TypeFromDecl<Super, Decl> {
     const ast::TypeParamList* type_params() const override { return this->decl.type_params.get(); }
 
 protected:
-    PolyTypeFromDecl(TypeTable& type_table, const Decl& decl)
-        : TypeFromDecl<Super, Decl>(type_table, decl)
+    PolyTypeFromDecl(TypeTable& type_table, TypeKind kind, const Decl& decl)
+        : TypeFromDecl<Super, Decl>(type_table, kind, decl)
     {}
 };
 
@@ -456,9 +566,12 @@ struct ForallType : public PolyTypeFromDecl<PolyType, ast::FnDecl> {
 
     void print(Printer&) const override;
 
+    using ClassOf = ForallType;
+    static bool classof(const Type* type) { return type->kind == TypeKind::Forall; }
+
 private:
     ForallType(TypeTable& type_table, const ast::FnDecl& decl)
-        : PolyTypeFromDecl(type_table, decl)
+        : PolyTypeFromDecl(type_table, TypeKind::Forall, decl)
     {}
 
     friend class TypeTable;
@@ -466,8 +579,8 @@ private:
 
 /// Base class for user-declared types.
 struct UserType : public PolyType {
-    UserType(TypeTable& type_table)
-        : PolyType(type_table)
+    UserType(TypeTable& type_table, TypeKind kind)
+        : PolyType(type_table, kind)
     {}
 
     virtual const thorin::Type* convert(Emitter&, const Type*) const;
@@ -475,23 +588,40 @@ struct UserType : public PolyType {
     const thorin::Type* convert(Emitter& emitter) const override {
         return convert(emitter, this);
     }
+
+    using ClassOf = UserType;
+    static bool classof(const Type* type) {
+        return type->kind >= TypeKind::Struct && type->kind <= TypeKind::Alias;
+    }
 };
 
 /// Base class for complex, user-declared types.
 struct ComplexType : public UserType {
-    ComplexType(TypeTable& type_table)
-        : UserType(type_table)
+    ComplexType(TypeTable& type_table, TypeKind kind)
+        : UserType(type_table, kind)
     {}
 
-    std::optional<size_t> find_member(const std::string_view&) const;
+    std::optional<size_t> find_member(Name) const;
 
-    virtual std::string_view member_name(size_t) const = 0;
+    virtual Name member_name(size_t) const = 0;
     virtual const Type* member_type(size_t) const = 0;
     virtual size_t member_count() const = 0;
 
     using Type::is_sized;
     size_t order(std::unordered_set<const Type*>&) const override;
     bool is_sized(std::unordered_set<const Type*>&) const override;
+
+    using ClassOf = ComplexType;
+    static bool classof(const Type* type) {
+        return type->kind >= TypeKind::Struct && type->kind <= TypeKind::Mod;
+    }
+
+private:
+    /// Types with fewer members are searched linearly.
+    static constexpr size_t min_indexed_members = 8;
+
+    /// Map from member names to member indices, built on the first lookup.
+    mutable std::unique_ptr<std::unordered_map<Name, size_t>> member_index_;
 };
 
 struct StructType : public TypeFromDecl<ComplexType, ast::RecordDecl> {
@@ -503,15 +633,18 @@ struct StructType : public TypeFromDecl<ComplexType, ast::RecordDecl> {
     const thorin::Type* convert(Emitter&, const Type*) const override;
     std::string stringify(Emitter&) const override;
 
-    std::string_view member_name(size_t) const override;
+    Name member_name(size_t) const override;
     const Type* member_type(size_t) const override;
     size_t member_count() const override;
 
     bool is_tuple_like() const;
 
+    using ClassOf = StructType;
+    static bool classof(const Type* type) { return type->kind == TypeKind::Struct; }
+
 private:
     StructType(TypeTable& type_table, const ast::RecordDecl& decl)
-        : TypeFromDecl(type_table, decl)
+        : TypeFromDecl(type_table, TypeKind::Struct, decl)
     {}
 
     friend class TypeTable;
@@ -524,7 +657,7 @@ struct EnumType : public PolyTypeFromDecl<ComplexType, ast::EnumDecl> {
     const thorin::Type* convert(Emitter&, const Type*) const override;
     std::string stringify(Emitter&) const override;
 
-    std::string_view member_name(size_t) const override;
+    Name member_name(size_t) const override;
     const Type* member_type(size_t) const override;
     size_t member_count() const override;
 
@@ -532,9 +665,12 @@ struct EnumType : public PolyTypeFromDecl<ComplexType, ast::EnumDecl> {
     // of constructors without arguments.
     bool is_trivial() const;
 
+    using ClassOf = EnumType;
+    static bool classof(const Type* type) { return type->kind == TypeKind::Enum; }
+
 private:
     EnumType(TypeTable& type_table, const ast::EnumDecl& decl)
-        : PolyTypeFromDecl(type_table, decl)
+        : PolyTypeFromDecl(type_table, TypeKind::Enum, decl)
     {}
 
     friend class TypeTable;
@@ -543,18 +679,21 @@ private:
 struct ModType : public TypeFromDecl<ComplexType, ast::ModDecl> {
     void print(Printer&) const override;
 
-    std::string_view member_name(size_t) const override;
+    Name member_name(size_t) const override;
     const Type* member_type(size_t) const override;
     size_t member_count() const override;
 
     ast::NamedDecl& member(size_t) const;
 
+    using ClassOf = ModType;
+    static bool classof(const Type* type) { return type->kind == TypeKind::Mod; }
+
 private:
     struct Member {
-        std::string name;
+        Name name;
         ast::NamedDecl& decl;
 
-        Member(const std::string& name, ast::NamedDecl& decl)
+        Member(Name name, ast::NamedDecl& decl)
             : name(name), decl(decl)
         {}
     };
@@ -562,7 +701,7 @@ private:
     mutable std::unique_ptr<Members> members_;
 
     ModType(TypeTable& type_table, const ast::ModDecl& decl)
-        : TypeFromDecl(type_table, decl)
+        : TypeFromDecl(type_table, TypeKind::Mod, decl)
     {}
 
     const Members& members() const;
@@ -574,9 +713,12 @@ private:
 struct TypeAlias : public PolyTypeFromDecl<UserType, ast::TypeDecl> {
     void print(Printer&) const override;
 
+    using ClassOf = TypeAlias;
+    static bool classof(const Type* type) { return type->kind == TypeKind::Alias; }
+
 private:
     TypeAlias(TypeTable& type_table, const ast::TypeDecl& decl)
-        : PolyTypeFromDecl(type_table, decl)
+        : PolyTypeFromDecl(type_table, TypeKind::Alias, decl)
     {}
 
     friend class TypeTable;
@@ -585,7 +727,7 @@ private:
 /// An application of a complex type with polymorphic parameters.
 struct TypeApp : public Type {
     const UserType* applied;
-    Array<const Type*> type_args;
+    ArrayRef<const Type*> type_args;
 
     /// Gets the replacement map required to expand this type application.
     ReplaceMap replace_map() const {
@@ -597,8 +739,8 @@ struct TypeApp : public Type {
     const Type* member_type(size_t i) const;
 
     void print(Printer&) const override;
-    bool equals(const Type*) const override;
-    size_t hash() const override;
+    bool equals(const Type*) const;
+    size_t compute_hash() const;
     bool contains(const Type*) const override;
 
     const Type* replace(const ReplaceMap&) const override;
@@ -615,14 +757,17 @@ struct TypeApp : public Type {
         const ast::TypeParamList& type_params,
         const ArrayRef<const Type*>& type_args);
 
+    using ClassOf = TypeApp;
+    static bool classof(const Type* type) { return type->kind == TypeKind::App; }
+
 private:
     TypeApp(
         TypeTable& type_table,
         const UserType* applied,
         const ArrayRef<const Type*>& type_args)
-        : Type(type_table)
+        : Type(type_table, TypeKind::App)
         , applied(applied)
-        , type_args(std::move(type_args))
+        , type_args(type_args)
     {}
 
     friend class TypeTable;
@@ -661,7 +806,19 @@ std::pair<const TypeApp*, const T*> match_app(const Type* type) {
 /// Hash table containing all types.
 class TypeTable {
 public:
-    ~TypeTable();
+    /// Number of lookups in a cache that did, or did not, find a result.
+    struct CacheStats {
+        size_t hits   = 0;
+        size_t misses = 0;
+    };
+
+    /// Statistics about the caches of the type table.
+    struct Stats {
+        CacheStats subtype;
+        CacheStats join;
+    };
+
+    TypeTable();
 
     const PrimType*          prim_type(ast::PrimType::Tag);
     const PrimType*          bool_type();
@@ -689,21 +846,77 @@ public:
     /// or returns the type alias expanded with the given type arguments.
     const Type* type_app(const UserType*, const ArrayRef<const Type*>&);
 
+    /// Replaces the type variables that appear in a type according to the given map.
+    /// Results are cached, so that a substitution is only applied once to a given type.
+    const Type* replace(const Type*, const ReplaceMap&);
+    /// Instantiates the body of a polymorphic function type with the given type arguments.
+    /// Results are cached in the same way as for `replace()`.
+    const Type* instantiate(const ForallType*, const ArrayRef<const Type*>&);
+
+    const Stats& stats() const { return stats_; }
+
 private:
     template <typename T, typename... Args>
     const T* insert(Args&&...);
 
-    struct HashType {
-        size_t operator () (const Type* type) const {
-            return type->hash();
+    ArrayRef<const Type*> copy(const ArrayRef<const Type*>&);
+    void rehash(size_t);
+
+    struct HashTypePair {
+        size_t operator () (const std::pair<const Type*, const Type*>& pair) const {
+            return fnv::Hash().combine(pair.first).combine(pair.second);
         }
     };
-    struct CompareTypes {
-        bool operator () (const Type* left, const Type* right) const {
-            return left->equals(right);
+    template <typename T>
+    using TypePairMap = std::unordered_map<std::pair<const Type*, const Type*>, T, HashTypePair>;
+
+    /// Identifies the application of a substitution, or of type arguments, to a type.
+    /// The types of the key only refer to memory owned by the type table once inserted.
+    struct SubstKey {
+        const Type* type;
+        ArrayRef<const Type*> types;
+        size_t hash;
+
+        SubstKey(const Type* type, const ArrayRef<const Type*>& types)
+            : type(type), types(types)
+        {
+            fnv::Hash h;
+            h.combine(type);
+            for (auto t : types)
+                h.combine(t);
+            hash = h;
+        }
+
+        bool operator == (const SubstKey& other) const {
+            return
+                type == other.type &&
+                types.size() == other.types.size() &&
+                std::equal(types.begin(), types.end(), other.types.begin());
         }
     };
-    std::unordered_set<const Type*, HashType, CompareTypes> types_;
+    struct HashSubstKey {
+        size_t operator () (const SubstKey& key) const { return key.hash; }
+    };
+    using SubstMap = std::unordered_map<SubstKey, const Type*, HashSubstKey>;
+
+    static constexpr size_t min_capacity = 256;
+
+    // Open-addressing hash set with linear probing, whose capacity is a power of two
+    std::vector<const Type*> types_;
+    size_t type_count_ = 0;
+    Arena arena_;
+
+    SubstMap replace_cache_;
+    SubstMap instantiate_cache_;
+
+    TypePairMap<bool> subtype_cache_;
+    TypePairMap<const Type*> join_cache_;
+
+    // Indexed by the direction given to `Type::variance()`
+    TypeMap<TypeVarMap<TypeVariance>> variance_cache_[2];
+    Stats stats_;
+
+    friend struct Type;
 
     const PrimType*   bool_type_   = nullptr;
     const TupleType*  unit_type_   = nullptr;
@@ -1,30 +1,93 @@
 #include "artic/arena.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <cstdint>
+#include <cassert>
+#include <new>
 
-Arena::Arena() : _block_size(4096) {
-    _data = { malloc(_block_size) };
-    _available = _block_size;
+static inline uintptr_t align_up(uintptr_t ptr, size_t align) {
+    assert((align & (align - 1)) == 0);
+    return (ptr + align - 1) & ~uintptr_t(align - 1);
+}
+
+static inline void* alloc_or_throw(size_t size) {
+    void* data = malloc(size);
+    if (!data)
+        throw std::bad_alloc();
+    return data;
+}
+
+Arena::Arena() : _cur(0) {
+    _blocks = { Block { alloc_or_throw(min_block_size), min_block_size } };
+    _available = min_block_size;
+    _stats.num_blocks = 1;
+    _stats.reserved = min_block_size;
 }
 
 Arena::~Arena() {
     for (auto [f, p] : _cleanup) {
         f(p);
     }
-    for (auto& ptr : _data)
+    for (auto& block : _blocks)
+        free(block.data);
+    for (auto& ptr : _large)
         free(ptr);
 }
 
+void Arena::rewind(const Mark& mark) {
+    assert(mark.block <= _cur && mark.large <= _large.size() && mark.cleanup <= _cleanup.size());
+    for (size_t i = mark.cleanup, n = _cleanup.size(); i < n; ++i) {
+        auto [f, p] = _cleanup[i];
+        f(p);
+    }
+    _cleanup.resize(mark.cleanup);
+    for (size_t i = mark.large, n = _large.size(); i < n; ++i)
+        free(_large[i]);
+    _large.resize(mark.large);
+    _cur = mark.block;
+    _available = mark.available;
+}
+
+void Arena::reset() {
+    rewind(Mark { 0, _blocks.front().size, 0, 0 });
+}
+
 void Arena::grow() {
-    _block_size *= 2;
-    _data.push_back( malloc(_block_size) );
-    _available = _block_size;
+    _stats.wasted += _available;
+    // Reuse the blocks that were kept after rewinding the arena, if any
+    if (++_cur == _blocks.size()) {
+        auto size = std::min(_blocks.back().size * 2, max_block_size);
+        _blocks.push_back(Block { alloc_or_throw(size), size });
+        _stats.num_blocks++;
+        _stats.reserved += size;
+    }
+    _available = _blocks[_cur].size;
 }
 
-void* Arena::alloc(size_t size) {
-    while (size > _available)
+void* Arena::alloc_large(size_t size, size_t align) {
+    // Over-allocate so that the object can be aligned without relying on aligned allocation functions
+    void* data = alloc_or_throw(size + align - 1);
+    _large.push_back(data);
+    _stats.num_large++;
+    _stats.large += size;
+    return reinterpret_cast<void*>(align_up(reinterpret_cast<uintptr_t>(data), align));
+}
+
+void* Arena::alloc(size_t size, size_t align) {
+    auto& block = _blocks[_cur];
+    auto cur = reinterpret_cast<uintptr_t>(block.data) + block.size - _available;
+    auto ptr = align_up(cur, align);
+    auto padding = ptr - cur;
+    if (size + padding > _available) {
+        // Large objects get their own allocation, which keeps the rest of the current block usable
+        if (size + align > block.size / 4)
+            return alloc_large(size, align);
         grow();
-    size_t ptr = reinterpret_cast<size_t>(_data.back()) + _block_size - _available;
-    _available -= size;
+        return alloc(size, align);
+    }
+    _available -= size + padding;
+    _stats.used += size;
+    _stats.wasted += padding;
     return reinterpret_cast<void*>(ptr);
 }
@@ -6,6 +6,20 @@
 
 namespace artic::ast {
 
+// The arena only has to register a destructor for the few nodes that own memory outside of it
+static_assert(std::is_trivially_destructible_v<Path>);
+static_assert(std::is_trivially_destructible_v<NamedAttr>);
+static_assert(std::is_trivially_destructible_v<LiteralExpr>);
+static_assert(std::is_trivially_destructible_v<PathExpr>);
+static_assert(std::is_trivially_destructible_v<TupleExpr>);
+static_assert(std::is_trivially_destructible_v<BlockExpr>);
+static_assert(std::is_trivially_destructible_v<MatchExpr>);
+static_assert(std::is_trivially_destructible_v<FnDecl>);
+static_assert(std::is_trivially_destructible_v<StructDecl>);
+static_assert(std::is_trivially_destructible_v<EnumDecl>);
+static_assert(std::is_trivially_destructible_v<ModDecl>);
+static_assert(std::is_trivially_destructible_v<RecordPtrn>);
+
 bool Type::is_tuple() const { return isa<TupleType>(); }
 bool Expr::is_tuple() const { return isa<TupleExpr>(); }
 bool Ptrn::is_tuple() const { return isa<TuplePtrn>(); }
@@ -31,7 +45,7 @@ std::string PrimType::tag_to_string(Tag tag) {
 }
 
 PrimType::Tag PrimType::tag_from_token(const Token& token) {
-    static std::unordered_map<std::string, Tag> tag_map{
+    static std::unordered_map<std::string_view, Tag> tag_map{
         std::make_pair("bool", Bool),
 
         std::make_pair("i8",  I8),
@@ -639,7 +653,7 @@ const Expr* IdPtrn::to_expr(Arena& arena) {
     if (as_expr)
         return as_expr.get();
     Identifier id = decl->id;
-    std::vector<Path::Elem> elems;
+    arena_vector<Path::Elem> elems(arena);
     elems.push_back(Path::Elem( loc, std::move(id), {} ));
     Path path = Path(loc, std::move(elems));
     path.start_decl = decl.get();
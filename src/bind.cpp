@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+
 #include "artic/bind.h"
 #include "artic/ast.h"
 
@@ -19,35 +23,83 @@ void NameBinder::bind(ast::Node& node) {
 }
 
 void NameBinder::pop_scope() {
-    for (auto& pair : scopes_.back().symbols) {
-        auto decl = pair.second.decl;
-        if (pair.second.use_count == 0 &&
-            !scopes_.back().top_level &&
-            !decl->isa<ast::FieldDecl>() &&
-            !decl->isa<ast::OptionDecl>()) {
-            warn(decl->loc, "unused identifier '{}'", pair.first);
-            note("prefix unused identifiers with '_'");
+    auto cur_scope = symbols_.depth() - 1;
+    if (!symbols_.is_top_level(cur_scope)) {
+        auto [begin, end] = symbols_.bindings(cur_scope);
+        for (auto binding = begin; binding != end; ++binding) {
+            auto decl = binding->value.decl;
+            if (!binding->erased &&
+                binding->value.use_count == 0 &&
+                !decl->isa<ast::FieldDecl>() &&
+                !decl->isa<ast::OptionDecl>()) {
+                warn(decl->loc, "unused identifier '{}'", binding->key);
+                note("prefix unused identifiers with '_'");
+            }
+        }
+    }
+    symbols_.pop_scope();
+}
+
+/// Computes the edit distance between two strings, capped to `max`. Only the cells
+/// of the dynamic programming matrix that are within `max` of the diagonal are
+/// computed, since the others necessarily hold a distance greater than `max`.
+/// The cell of row `i` and column `j` is stored at index `j - i + max` of a fixed
+/// buffer, so that no memory is allocated, whatever the length of the strings.
+size_t NameBinder::levenshtein(std::string_view a, std::string_view b, size_t max) {
+    assert(max <= levenshtein_threshold());
+    if (a.size() > b.size())
+        std::swap(a, b);
+    if (b.size() - a.size() >= max)
+        return max;
+
+    // Cells outside of the matrix, or outside of the band, are considered to be at distance `max`
+    std::array<size_t, 2 * levenshtein_threshold() + 1> band;
+    auto width = 2 * max + 1;
+    for (size_t k = 0; k < width; ++k)
+        band[k] = k >= max ? std::min(k - max, max) : max;
+    for (size_t i = 1; i <= a.size(); ++i) {
+        size_t row_min = max;
+        // Updating the band in place works because the cell at index `k` of the previous row is
+        // the diagonal neighbor, and the cell at index `k + 1` is the upper neighbor.
+        for (size_t k = 0; k < width; ++k) {
+            if (i + k < max || i + k - max > b.size()) {
+                band[k] = max;
+                continue;
+            }
+            size_t j = i + k - max;
+            if (j == 0) {
+                band[k] = std::min(i, max);
+            } else {
+                size_t up   = k + 1 < width ? band[k + 1] : max;
+                size_t left = k > 0 ? band[k - 1] : max;
+                band[k] = std::min({ up + 1, left + 1, band[k] + (a[i - 1] != b[j - 1] ? 1 : 0), max });
+            }
+            row_min = std::min(row_min, band[k]);
         }
+        if (row_min >= max)
+            return max;
     }
-    scopes_.pop_back();
+    return band[b.size() - a.size() + max];
 }
 
-void NameBinder::insert_symbol(ast::NamedDecl& decl, const std::string& name) {
-    assert(!scopes_.empty());
+void NameBinder::insert_symbol(ast::NamedDecl& decl, Name name) {
+    assert(symbols_.depth() > 0);
     assert(!name.empty());
 
     // Do not bind anonymous variables
-    if (name[0] == '_') return;
+    if (name.str()[0] == '_') return;
 
+    // The symbol must be read before inserting, as insertions invalidate it
     auto shadow_symbol = find_symbol(name);
-    if (!scopes_.back().insert(name, Symbol(&decl))) {
+    auto shadow_decl = shadow_symbol ? shadow_symbol->decl : nullptr;
+    if (!symbols_.insert(name, Symbol(&decl))) {
         error(decl.loc, "identifier '{}' already declared", name);
-        note(shadow_symbol->decl->loc, "previously declared here");
+        note(shadow_decl->loc, "previously declared here");
     } else if (
-        warn_on_shadowing && shadow_symbol &&
-        decl.isa<ast::PtrnDecl>() && !shadow_symbol->decl->is_top_level) {
+        warn_on_shadowing && shadow_decl &&
+        decl.isa<ast::PtrnDecl>() && !shadow_decl->is_top_level) {
         warn(decl.loc, "declaration shadows identifier '{}'", name);
-        note(shadow_symbol->decl->loc, "previously declared here");
+        note(shadow_decl->loc, "previously declared here");
     }
 }
 
@@ -58,7 +110,7 @@ namespace ast {
 void Path::bind(NameBinder& binder) {
     // Bind the first element of the path
     auto& first = elems.front();
-    if (first.id.name[0] == '_')
+    if (first.id.name.str()[0] == '_')
         binder.error(first.id.loc, "identifiers beginning with '_' cannot be referenced");
     else if (first.is_super()) {
         start_decl = binder.cur_mod->super;
@@ -523,14 +575,14 @@ void ModDecl::bind_head(NameBinder& binder) {
 
 void ModDecl::bind(NameBinder& binder) {
     // Symbols defined outside the module are not visible inside it.
-    std::vector<SymbolTable> old_scopes;
-    std::swap(binder.scopes_, old_scopes);
+    SymbolTable old_symbols;
+    std::swap(binder.symbols_, old_symbols);
     auto old_mod = binder.cur_mod;
     binder.cur_mod = this;
     binder.push_scope();
     for (auto& decl : decls) binder.bind_head(*decl);
     for (auto& decl : decls) binder.bind(*decl);
-    std::swap(binder.scopes_, old_scopes);
+    std::swap(binder.symbols_, old_symbols);
     binder.cur_mod = old_mod;
 }
 
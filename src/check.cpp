@@ -46,8 +46,8 @@ const Type* TypeChecker::type_expected(const Loc& loc, const artic::Type* type,
     return type_table.type_error();
 }
 
-const Type* TypeChecker::unknown_member(const Loc& loc, const UserType* user_type, const std::string_view& member) {
-    if (auto mod_type = user_type->isa<ModType>(); mod_type && mod_type->decl.id.name == "")
+const Type* TypeChecker::unknown_member(const Loc& loc, const UserType* user_type, Name member) {
+    if (auto mod_type = user_type->isa<ModType>(); mod_type && mod_type->decl.id.name.empty())
         error(loc, "no member '{}' in top-level module", member);
     else
         error(loc, "no member '{}' in '{}'", member, *user_type);
@@ -178,7 +178,7 @@ const Type* TypeChecker::coerce(Ptr<ast::Expr>& expr, const Type* expected) {
         auto loc = expr->loc;
         auto deconstructed = expr->isa<ast::TupleExpr>();
         auto tuple_t = expected->as<TupleType>();
-        PtrVector<ast::Expr> args;
+        PtrVector<ast::Expr> args(_arena);
         for (size_t i = 0; i < tuple_t->args.size(); i++) {
             if (!deconstructed) {
                 if (i == 0 && !is_unit(expr)) {
@@ -446,7 +446,7 @@ void TypeChecker::check_refutability(const ast::Ptrn& ptrn, bool must_be_trivial
 }
 
 bool TypeChecker::check_attrs(const ast::NamedAttr& named_attr, const ArrayRef<AttrType>& attr_types) {
-    std::unordered_map<std::string_view, const ast::Attr*> seen;
+    std::unordered_map<Name, const ast::Attr*> seen;
     for (auto& attr : named_attr.args) {
         if (!seen.emplace(attr->name, attr.get()).second) {
             error(attr->loc, "redeclaration of attribute '{}'", attr->name);
@@ -528,7 +528,7 @@ bool TypeChecker::infer_type_args(
     std::vector<const Type*>& type_args)
 {
     auto bounds = forall_type->body->as<FnType>()->dom->bounds(arg_type);
-    auto variance = forall_type->body->as<FnType>()->codom->variance(true);
+    auto& variance = forall_type->body->as<FnType>()->codom->variance(true);
     for (auto& bound : bounds) {
         size_t index = std::find_if(
             forall_type->decl.type_params->params.begin(),
@@ -556,7 +556,8 @@ bool TypeChecker::infer_type_args(
 
         // Compute the type argument based on the bounds and variance of that type variable.
         // See "Local Type Inference", by B. Pierce and D. Turner.
-        switch (variance[bound.first]) {
+        auto it = variance.find(bound.first);
+        switch (it != variance.end() ? it->second : TypeVariance::Constant) {
             case TypeVariance::Constant:
             case TypeVariance::Covariant:
                 type_args[index] = bound.second.lower;
@@ -662,7 +663,7 @@ const artic::Type* Path::infer(TypeChecker& checker, bool value_expected, Ptr<Ex
                     if (!checker.infer_type_args(loc, forall_type, arg_type, type_args))
                         return checker.type_table.type_error();
                 }
-                elem.inferred_args = type_args;
+                elem.inferred_args = arena_vector<const artic::Type*>(checker.arena(), type_args.begin(), type_args.end());
                 type = user_type
                     ? checker.type_table.type_app(user_type, std::move(type_args))
                     : forall_type->instantiate(type_args);
@@ -773,11 +774,11 @@ void NamedAttr::check(TypeChecker& checker, const ast::Node* node) {
                         AttrType { "name", AttrType::String }
                     }))
                 {
-                    auto name = fn_decl->id.name;
+                    std::string name = fn_decl->id.name;
                     if (auto name_attr = find("name"))
                         name = name_attr->as<LiteralAttr>()->lit.as_string();
                     if (auto cc_attr = find("cc")) {
-                        auto& cc = cc_attr->as<LiteralAttr>()->lit.as_string();
+                        auto cc = cc_attr->as<LiteralAttr>()->lit.as_string();
                         if (cc == "builtin") {
                             static const std::unordered_set<std::string> builtins = {
                                 "alignof", "bitcast", "insert", "select", "sizeof", "undef", "compare",
@@ -816,15 +817,15 @@ void NamedAttr::check(TypeChecker& checker, const ast::Node* node) {
     } else if (name == "intern") {
         checker.check_attrs(*this, std::array<AttrType, 1> { AttrType { "name", AttrType::String } });
     } else
-        checker.invalid_attr(loc, name);
+        checker.invalid_attr(loc, name.str());
 }
 
 void PathAttr::check(TypeChecker& checker, const ast::Node*) {
-    checker.invalid_attr(loc, name);
+    checker.invalid_attr(loc, name.str());
 }
 
 void LiteralAttr::check(TypeChecker& checker, const ast::Node*) {
-    checker.invalid_attr(loc, name);
+    checker.invalid_attr(loc, name.str());
 }
 
 void AttrList::check(TypeChecker& checker, const ast::Node* parent) {
@@ -857,7 +858,9 @@ const artic::Type* SizedArrayType::infer(TypeChecker& checker) {
         for (size_t i = 0, n = path.elems.size(); i < n; ++i) {
             if (path.elems[i].is_super())
                 decl = i == 0 ? path.start_decl : decl->as<ModDecl>()->super;
-            if (auto mod_type = path.elems[i].type->isa<ModType>()) {
+            // Path elements are not typed when the path has not been inferred
+            auto mod_type = path.elems[i].type ? path.elems[i].type->isa<ModType>() : nullptr;
+            if (mod_type) {
                 decl = &mod_type->member(path.elems[i + 1].index);
             } else if (!path.is_ctor) {
                 assert(path.elems[i].inferred_args.empty());
@@ -1032,7 +1035,9 @@ const artic::Type* RepeatArrayExpr::infer(TypeChecker& checker) {
         for (size_t i = 0, n = path.elems.size(); i < n; ++i) {
             if (path.elems[i].is_super())
                 decl = i == 0 ? path.start_decl : decl->as<ModDecl>()->super;
-            if (auto mod_type = path.elems[i].type->isa<ModType>()) {
+            // Path elements are not typed when the path has not been inferred
+            auto mod_type = path.elems[i].type ? path.elems[i].type->isa<ModType>() : nullptr;
+            if (mod_type) {
                 decl = &mod_type->member(path.elems[i + 1].index);
             } else if (!path.is_ctor) {
                 assert(path.elems[i].inferred_args.empty());
@@ -1065,7 +1070,9 @@ const artic::Type* RepeatArrayExpr::check(TypeChecker& checker, const artic::Typ
         for (size_t i = 0, n = path.elems.size(); i < n; ++i) {
             if (path.elems[i].is_super())
                 decl = i == 0 ? path.start_decl : decl->as<ModDecl>()->super;
-            if (auto mod_type = path.elems[i].type->isa<ModType>()) {
+            // Path elements are not typed when the path has not been inferred
+            auto mod_type = path.elems[i].type ? path.elems[i].type->isa<ModType>() : nullptr;
+            if (mod_type) {
                 decl = &mod_type->member(path.elems[i + 1].index);
             } else if (!path.is_ctor) {
                 assert(path.elems[i].inferred_args.empty());
@@ -58,13 +58,47 @@ private:
     using Value = std::pair<const thorin::Def*, const Type*>;
     using Cost = size_t;
 
+    // Sub-problem of the decision tree, made of the rows and values it is compiled from.
+    struct SubProblem {
+        std::vector<Row> rows;
+        std::vector<Value> values;
+
+        bool operator == (const SubProblem& other) const {
+            return rows == other.rows && values == other.values;
+        }
+    };
+
+    struct HashSubProblem {
+        size_t operator () (const SubProblem& sub_problem) const {
+            auto h = fnv::Hash();
+            for (auto& row : sub_problem.rows) {
+                for (auto ptrn : row.first)
+                    h.combine(ptrn);
+                h.combine(row.second);
+            }
+            for (auto& value : sub_problem.values)
+                h.combine(value.first).combine(value.second);
+            return h;
+        }
+    };
+
+    // Map from sub-problems to the block in which they have been compiled.
+    using SubProblemMap = std::unordered_map<SubProblem, thorin::Continuation*, HashSubProblem>;
+    // Map from string literal patterns to the patterns of their characters. These are created
+    // once per match expression, so that identical sub-problems refer to the same patterns.
+    using CharPtrnMap = std::unordered_map<const ast::LiteralPtrn*, PtrVector<ast::Ptrn>>;
+
     Emitter& emitter;
     const ast::Node& node;
     const ast::Expr& expr;
     std::vector<Row> rows;
     std::vector<Value> values;
     std::unordered_map<const ast::IdPtrn*, const thorin::Def*>& matched_values;
-    PtrVector<ast::Ptrn> tmp_ptrns;
+    SubProblemMap& sub_problems;
+    CharPtrnMap& char_ptrns;
+    // The root of the decision tree is compiled in the block of the match expression,
+    // which may already contain other instructions, and thus cannot be shared.
+    bool is_root = false;
 
     PtrnCompiler(
         Emitter& emitter,
@@ -72,13 +106,17 @@ private:
         const ast::Expr& expr,
         std::vector<Row>&& rows,
         std::vector<Value>&& values,
-        std::unordered_map<const ast::IdPtrn*, const thorin::Def*>& matched_values)
+        std::unordered_map<const ast::IdPtrn*, const thorin::Def*>& matched_values,
+        SubProblemMap& sub_problems,
+        CharPtrnMap& char_ptrns)
         : emitter(emitter)
         , node(node)
         , expr(expr)
         , rows(std::move(rows))
         , values(std::move(values))
         , matched_values(matched_values)
+        , sub_problems(sub_problems)
+        , char_ptrns(char_ptrns)
     {}
 
     static bool is_wildcard(const ast::Ptrn* ptrn) {
@@ -202,13 +240,18 @@ private:
                         // pattern for each character.
                         assert(literal_ptrn->lit.is_string());
                         assert(literal_ptrn->lit.as_string().size() + 1 == member_count);
-                        const char* str = literal_ptrn->lit.as_string().c_str();
-                        for (size_t j = 0; j < member_count; ++j) {
-                            auto char_ptrn = emitter.arena.make_ptr<ast::LiteralPtrn>(literal_ptrn->loc, uint8_t(str[j]));
-                            char_ptrn->type = type->type_table.prim_type(ast::PrimType::U8);
-                            new_elems[j] = char_ptrn.get();
-                            tmp_ptrns.emplace_back(std::move(char_ptrn));
+                        auto [it, inserted] = char_ptrns.try_emplace(literal_ptrn, emitter.arena);
+                        if (inserted) {
+                            auto str = literal_ptrn->lit.as_string();
+                            for (size_t j = 0; j < member_count; ++j) {
+                                auto c = j < str.size() ? str[j] : 0;
+                                auto char_ptrn = emitter.arena.make_ptr<ast::LiteralPtrn>(literal_ptrn->loc, uint8_t(c));
+                                char_ptrn->type = type->type_table.prim_type(ast::PrimType::U8);
+                                it->second.emplace_back(std::move(char_ptrn));
+                            }
                         }
+                        for (size_t j = 0; j < member_count; ++j)
+                            new_elems[j] = it->second[j].get();
                     } else {
                         matched_values.emplace(row.first[i]->as<ast::IdPtrn>(), values[i].first);
                     }
@@ -259,6 +302,19 @@ private:
             return;
         }
 
+        // Identical sub-problems, reached through different paths in the decision tree, are
+        // compiled once. Leaves are not recorded, since they only jump to the body of a case.
+        // Other nodes are compiled in the fresh block created for them by their parent, which
+        // is then used as the target for the other paths leading to the same sub-problem.
+        if (emitter.state.cont && !is_root) {
+            auto [it, inserted] = sub_problems.emplace(SubProblem { rows, values }, emitter.state.cont);
+            if (!inserted) {
+                emitter.match_stats.shared_nodes++;
+                return emitter.jump(it->second);
+            }
+        }
+        emitter.match_stats.nodes++;
+
 #ifndef NDEBUG
         for (auto& row : rows)
             assert(row.first.size() == values.size());
@@ -320,11 +376,11 @@ private:
             for (auto& ctor : ctors) {
                 auto _ = emitter.save_state();
                 emitter.enter(thorin::is_allset(ctor.first) ? match_true : match_false);
-                PtrnCompiler(emitter, node, expr, std::move(ctor.second), std::vector<Value>(values), matched_values).compile();
+                PtrnCompiler(emitter, node, expr, std::move(ctor.second), std::vector<Value>(values), matched_values, sub_problems, char_ptrns).compile();
             }
             if (!no_default) {
                 emitter.enter(thorin::is_allset(ctors.begin()->first) ? match_false : match_true);
-                PtrnCompiler(emitter, node, expr, std::move(wildcards), std::move(values), matched_values).compile();
+                PtrnCompiler(emitter, node, expr, std::move(wildcards), std::move(values), matched_values, sub_problems, char_ptrns).compile();
             }
         } else {
             assert(enum_type || is_int_type(col_type));
@@ -332,23 +388,29 @@ private:
             thorin::Array<const thorin::Def*> defs(ctors.size());
             auto otherwise = emitter.basic_block_with_mem(emitter.debug_info(node, "match_otherwise"));
 
-            size_t count = 0;
-            for (auto& ctor : ctors) {
-                defs[count] = ctor.first;
-                targets[count] = emitter.basic_block_with_mem(emitter.debug_info(node, "match_case"));
-                count++;
+            // Sort the cases by value, so that they can be split by range
+            bool is_signed = !enum_type && is_signed_int_type(col_type);
+            std::vector<const thorin::Def*> sorted_ctors;
+            for (auto& ctor : ctors)
+                sorted_ctors.push_back(ctor.first);
+            std::sort(sorted_ctors.begin(), sorted_ctors.end(), [is_signed] (auto a, auto b) {
+                return ctor_key(a, is_signed) < ctor_key(b, is_signed);
+            });
+            for (size_t i = 0, n = sorted_ctors.size(); i < n; ++i) {
+                defs[i] = sorted_ctors[i];
+                targets[i] = emitter.basic_block_with_mem(emitter.debug_info(node, "match_case"));
             }
 
             if (emitter.state.cont) {
+                auto _ = emitter.save_state();
                 auto match_value = enum_type
                    ? emitter.world.variant_index(values[col].first, emitter.debug_info(node, "variant_index"))
                    : values[col].first;
-                emitter.state.cont->match(
-                    emitter.state.mem,
+                emit_match(
                     match_value, otherwise,
-                    no_default ? defs.skip_back() : defs.ref(),
-                    no_default ? targets.skip_back() : targets.ref(),
-                    emitter.debug_info(node));
+                    defs.begin(), targets.begin(),
+                    no_default ? defs.size() - 1 : defs.size(),
+                    is_signed);
             }
 
             auto col_value = values[col].first;
@@ -370,14 +432,67 @@ private:
                         new_values.emplace_back(emitter.world.cast(type->convert(emitter), value), type);
                 }
 
-                PtrnCompiler(emitter, node, expr, std::move(rows), std::move(new_values), matched_values).compile();
+                PtrnCompiler(emitter, node, expr, std::move(rows), std::move(new_values), matched_values, sub_problems, char_ptrns).compile();
             }
             if (!no_default) {
                 emitter.enter(otherwise);
-                PtrnCompiler(emitter, node, expr, std::move(wildcards), std::move(values), matched_values).compile();
+                PtrnCompiler(emitter, node, expr, std::move(wildcards), std::move(values), matched_values, sub_problems, char_ptrns).compile();
             }
         }
     }
+
+    static bool is_signed_int_type(const Type* type) {
+        return
+            is_prim_type(type, ast::PrimType::I8)  ||
+            is_prim_type(type, ast::PrimType::I16) ||
+            is_prim_type(type, ast::PrimType::I32) ||
+            is_prim_type(type, ast::PrimType::I64);
+    }
+
+    // Returns an unsigned key for the given constructor index, in the same order as the index.
+    static uint64_t ctor_key(const thorin::Def* ctor, bool is_signed) {
+        // Flipping the sign bit maps signed integers to unsigned ones, preserving their order
+        return is_signed
+            ? uint64_t(thorin::primlit_value<int64_t>(ctor)) ^ (uint64_t(1) << 63)
+            : thorin::primlit_value<uint64_t>(ctor);
+    }
+
+    // Matches with at most this number of cases are always emitted as one multi-way branch.
+    static constexpr size_t max_match_cases = 8;
+
+    // Emits a multi-way branch to the given targets, given constructor indices sorted by value.
+    // Dense sets of cases are emitted as one multi-way branch, which the backends can lower to
+    // a jump table. Sparse ones are split into a binary search tree of comparisons first.
+    void emit_match(
+        const thorin::Def* value,
+        thorin::Continuation* otherwise,
+        const thorin::Def* const* defs,
+        thorin::Continuation* const* targets,
+        size_t count,
+        bool is_signed)
+    {
+        auto range = count > 0 ? ctor_key(defs[count - 1], is_signed) - ctor_key(defs[0], is_signed) : 0;
+        if (count <= max_match_cases || range / 4 < count) {
+            emitter.state.cont->match(
+                emitter.state.mem,
+                value, otherwise,
+                thorin::Array<const thorin::Def*>(defs, defs + count),
+                thorin::Array<thorin::Continuation*>(targets, targets + count),
+                emitter.debug_info(node));
+            emitter.state.cont = nullptr;
+            return;
+        }
+
+        auto mid = count / 2;
+        auto match_lower = emitter.basic_block_with_mem(emitter.debug_info(node, "match_lower"));
+        auto match_upper = emitter.basic_block_with_mem(emitter.debug_info(node, "match_upper"));
+        emitter.branch(emitter.world.cmp_lt(value, defs[mid]), match_lower, match_upper);
+        emitter.enter(match_lower);
+        emit_match(value, otherwise, defs, targets, mid, is_signed);
+        emitter.enter(match_upper);
+        emit_match(value, otherwise, defs + mid, targets + mid, count - mid, is_signed);
+    }
+
 #ifndef NDEBUG
     void dump() const;
 #endif
@@ -411,7 +526,10 @@ void PtrnCompiler::emit(
         rows.emplace_back(std::vector<const ast::Ptrn*>{ case_.ptrn }, &case_);
 
     std::vector<PtrnCompiler::Value> values = { { emitter.emit(expr), expr.type } };
-    auto compiler = PtrnCompiler(emitter, node, expr, std::move(rows), std::move(values), matched_values);
+    PtrnCompiler::SubProblemMap sub_problems;
+    PtrnCompiler::CharPtrnMap char_ptrns;
+    auto compiler = PtrnCompiler(emitter, node, expr, std::move(rows), std::move(values), matched_values, sub_problems, char_ptrns);
+    compiler.is_root = true;
     compiler.compile();
     for (auto &row : compiler.rows) {
         if (row.second->is_redundant)
@@ -472,6 +590,10 @@ thorin::Continuation* Emitter::basic_block_with_mem(const thorin::Type* param, t
     return world.continuation(continuation_type_with_mem(param), debug);
 }
 
+const Type* Emitter::replace_type_vars(const Type* type) {
+    return type->type_table.replace(type, type_vars);
+}
+
 const thorin::Def* Emitter::ctor_index(const ast::Ptrn& ptrn) {
     if (auto record_ptrn = ptrn.isa<ast::RecordPtrn>())
         return ctor_index(record_ptrn->variant_index, debug_info(ptrn));
@@ -737,26 +859,42 @@ const thorin::Def* Emitter::down_cast(const thorin::Def* def, const Type* from,
     return def;
 }
 
-const thorin::Def* Emitter::emit(const ast::Node& node) {
-    if (node.def) {
-        if (auto fndecl = node.isa<ast::FnDecl>()) {
-            if (!fndecl->type_params) {
-                return node.def;
-            }
-            //Multiple instances of the same FnDecl might be floating around.
-            //node.def might be set to the wrong instance!
-            //mono_fns is used to cache these instead.
-        } else {
-            return node.def;
-        }
+const thorin::Def* Emitter::def(const ast::Node& node) const {
+    for (auto it = instances.rbegin(); it != instances.rend(); ++it) {
+        // Outer instances of a function are hidden by its innermost instance, so that a
+        // nested instantiation of the same function does not reuse the outer definitions.
+        auto fn = it->fn;
+        if (std::any_of(it.base(), instances.end(), [fn] (const Instance& inner) { return inner.fn == fn; }))
+            continue;
+        if (auto def = it->defs.find(&node); def != it->defs.end())
+            return def->second;
     }
-    if (!poly_defs.empty())
-        poly_defs.back().push_back(&node.def);
-    return node.def = node.emit(*this);
+    return node.def;
+}
+
+void Emitter::set_def(const ast::Node& node, const thorin::Def* def) {
+    // Top-level declarations do not depend on the type variables of
+    // the instance they are emitted from, and can thus be shared.
+    auto decl = node.isa<ast::Decl>();
+    if (instances.empty() || (decl && decl->is_top_level))
+        node.def = def;
+    else
+        instances.back().defs[&node] = def;
+}
+
+const thorin::Def* Emitter::emit(const ast::Node& node) {
+    // Instances of polymorphic functions are cached in `mono_fns` instead
+    if (auto fn_decl = node.isa<ast::FnDecl>(); fn_decl && fn_decl->type_params)
+        return node.emit(*this);
+    if (auto def = this->def(node))
+        return def;
+    auto def = node.emit(*this);
+    set_def(node, def);
+    return def;
 }
 
 void Emitter::emit(const ast::Ptrn& ptrn, const thorin::Def* value) {
-    assert(!ptrn.def);
+    assert(!def(ptrn));
     ptrn.emit(*this, value);
 }
 
@@ -764,11 +902,11 @@ void Emitter::bind(const ast::IdPtrn& id_ptrn, const thorin::Def* value) {
     if (id_ptrn.decl->is_mut) {
         auto ptr = alloc(value->type(), debug_info(*id_ptrn.decl));
         store(ptr, value);
-        id_ptrn.decl->def = ptr;
+        set_def(*id_ptrn.decl, ptr);
         if (!id_ptrn.decl->written_to)
             warn(id_ptrn.loc, "mutable variable '{}' is never written to", id_ptrn.decl->id.name);
     } else {
-        id_ptrn.decl->def = value;
+        set_def(*id_ptrn.decl, value);
         value->set_name(id_ptrn.decl->id.name);
     }
     assert(id_ptrn.type->convert(*this) == value->type());
@@ -900,7 +1038,7 @@ const thorin::Def* Emitter::builtin(const ast::FnDecl& fn_decl, thorin::Continua
         cont->jump(cont->params().back(), call_args(cont->param(0), world.bottom(target_type)), debug_info(fn_decl));
     } else if (cont->name() == "compare") {
         enter(cont);
-        auto mono_type = member_type(fn_decl.fn->param->type->replace(type_vars), 1)->as<PtrType>()->pointee;
+        auto mono_type = member_type(replace_type_vars(fn_decl.fn->param->type), 1)->as<PtrType>()->pointee;
         auto ret_val = call(comparator(fn_decl.loc, mono_type), tuple_from_params(cont, true));
         jump(cont->params().back(), ret_val);
     } else {
@@ -1045,17 +1183,25 @@ static inline thorin::Pos position(const Loc::Pos& pos) {
     };
 }
 
-static inline thorin::Loc location(const Loc& loc) {
-    return thorin::Loc(loc.file->c_str(), position(loc.begin), position(loc.end));
+thorin::Loc Emitter::location(const Loc& loc) {
+    // Looking up the file table requires a lock, so the names are cached here
+    auto [it, inserted] = file_names.emplace(loc.file, nullptr);
+    if (inserted)
+        it->second = file_name(loc.file).c_str();
+    return thorin::Loc(it->second, position(loc.begin), position(loc.end));
 }
 
 thorin::Debug Emitter::debug_info(const ast::NamedDecl& decl) {
+    if (!debug)
+        return thorin::Debug(decl.id.name);
     return thorin::Debug(decl.id.name, location(decl.loc));
 }
 
 thorin::Debug Emitter::debug_info(const ast::Node& node, const std::string_view& name) {
     if (auto named_decl = node.isa<ast::NamedDecl>(); named_decl && name == "")
         return debug_info(*named_decl);
+    if (!debug)
+        return {};
     return thorin::Debug(std::string(name), location(node.loc));
 }
 
@@ -1086,11 +1232,11 @@ const thorin::Def* Path::emit(Emitter& emitter) const {
             decl = &mod_type->member(elems[i + 1].index);
         } else if (!is_ctor) {
             // If type arguments are present, this is a polymorphic application
-            std::unordered_map<const artic::TypeVar*, const artic::Type*> map;
+            artic::ReplaceMap map;
             if (!elems[i].inferred_args.empty()) {
                 for (size_t j = 0, n = elems[i].inferred_args.size(); j < n; ++j) {
                     auto var = decl->as<FnDecl>()->type_params->params[j]->type->as<artic::TypeVar>();
-                    auto type = elems[i].inferred_args[j]->replace(emitter.type_vars);
+                    auto type = emitter.replace_type_vars(elems[i].inferred_args[j]);
                     map.emplace(var, type);
                 }
                 // We need to also add the caller's map in case the function is nested in another
@@ -1098,14 +1244,8 @@ const thorin::Def* Path::emit(Emitter& emitter) const {
                 std::swap(map, emitter.type_vars);
             }
             auto def = emitter.emit(*decl);
-            if (!elems[i].inferred_args.empty()) {
-                // Polymorphic nodes are emitted with the map from type variable
-                // to concrete type, which means that the emitted node cannot be
-                // kept around: Another instantiation may be using a different map,
-                // which would conflict with this one.
-                decl->def = nullptr;
+            if (!elems[i].inferred_args.empty())
                 std::swap(map, emitter.type_vars);
-            }
             return def;
         } else if (match_app<StructType>(elems[i].type).second) {
             if (auto it = emitter.struct_ctors.find(elems[i].type); it != emitter.struct_ctors.end())
@@ -1128,7 +1268,7 @@ const thorin::Def* Path::emit(Emitter& emitter) const {
             // Find the variant constructor for that enum, if it exists.
             // Remember that the type application (if present) might be polymorphic (i.e. `E[T, U]::A`), and that, thus,
             // we need to replace bound type variables (`T` and `U` in the previous example) to find the constructor in the map.
-            Emitter::VariantCtor ctor { elems[i + 1].index, type_app ? type_app->replace(emitter.type_vars) : enum_type };
+            Emitter::VariantCtor ctor { elems[i + 1].index, type_app ? emitter.replace_type_vars(type_app) : enum_type };
             if (auto it = emitter.variant_ctors.find(ctor); it != emitter.variant_ctors.end())
                 return it->second;
             auto converted_type = (type_app
@@ -1213,11 +1353,38 @@ const thorin::Def* ArrayExpr::emit(Emitter& emitter) const {
         : emitter.world.definite_array(ops, emitter.debug_info(*this));
 }
 
+// Repeat arrays with more elements than this are filled with a loop when emitted in a function.
+static constexpr size_t max_repeat_array_ops = 64;
+
 const thorin::Def* RepeatArrayExpr::emit(Emitter& emitter) const {
-    thorin::Array<const thorin::Def*> ops(std::get<size_t>(size), emitter.emit(*elem));
-    return is_simd
-        ? emitter.world.vector(ops, emitter.debug_info(*this))
-        : emitter.world.definite_array(ops, emitter.debug_info(*this));
+    auto count = std::get<size_t>(size);
+    auto value = emitter.emit(*elem);
+    if (is_simd || count <= max_repeat_array_ops || !emitter.state.cont) {
+        thorin::Array<const thorin::Def*> ops(count, value);
+        return is_simd
+            ? emitter.world.vector(ops, emitter.debug_info(*this))
+            : emitter.world.definite_array(ops, emitter.debug_info(*this));
+    }
+
+    // Large arrays are stored in a local variable and filled with a loop,
+    // instead of creating an array with one operand per element.
+    auto index_type = emitter.world.type_qu64();
+    auto ptr = emitter.alloc(type->convert(emitter), emitter.debug_info(*this));
+    auto fill_head = emitter.basic_block_with_mem(index_type, emitter.debug_info(*this, "fill_head"));
+    auto fill_body = emitter.basic_block_with_mem(emitter.debug_info(*this, "fill_body"));
+    auto fill_exit = emitter.basic_block_with_mem(emitter.debug_info(*this, "fill_exit"));
+
+    emitter.jump(fill_head, emitter.world.literal_qu64(0, {}));
+    emitter.enter(fill_head);
+    auto index = fill_head->param(1);
+    emitter.branch(emitter.world.cmp_lt(index, emitter.world.literal_qu64(count, {})), fill_body, fill_exit);
+
+    emitter.enter(fill_body);
+    emitter.store(emitter.world.lea(ptr, index, {}), value);
+    emitter.jump(fill_head, emitter.world.arithop_add(index, emitter.world.literal_qu64(1, {})));
+
+    emitter.enter(fill_exit);
+    return emitter.load(ptr, emitter.debug_info(*this));
 }
 
 const thorin::Def* FieldExpr::emit(Emitter& emitter) const {
@@ -1272,7 +1439,7 @@ const thorin::Def* FnExpr::emit(Emitter& emitter) const {
         emitter.debug_info(*this));
     cont->params().back()->set_name("ret");
     // Set the IR node before entering the body
-    def = cont;
+    emitter.set_def(*this, cont);
     emitter.enter(cont);
     emitter.emit(*param, emitter.tuple_from_params(cont, true));
     if (filter)
@@ -1320,7 +1487,7 @@ const thorin::Def* ProjExpr::emit(Emitter& emitter) const {
 static inline std::pair<Ptr<IdPtrn>, Ptr<TupleExpr>> dummy_case(const Loc& loc, const artic::Type* type, Arena& arena) {
     // Create a dummy wildcard pattern '_' and empty tuple '()'
     // for the else/break branches of an `if let`/`while let`.
-    auto anon_decl   = arena.make_ptr<ast::PtrnDecl>(loc, Identifier(loc, "_"), false);
+    auto anon_decl   = arena.make_ptr<ast::PtrnDecl>(loc, Identifier(loc, Name("_")), false);
     auto anon_ptrn   = arena.make_ptr<ast::IdPtrn>(loc, std::move(anon_decl), nullptr);
     auto empty_tuple = arena.make_ptr<ast::TupleExpr>(loc, PtrVector<ast::Expr>());
     anon_ptrn->type  = type;
@@ -1452,8 +1619,8 @@ const thorin::Def* ContinueExpr::emit(Emitter&) const {
     return loop->continue_;
 }
 
-const thorin::Def* ReturnExpr::emit(Emitter&) const {
-    return fn->def->as_nom<thorin::Continuation>()->params().back();
+const thorin::Def* ReturnExpr::emit(Emitter& emitter) const {
+    return emitter.def(*fn)->as_nom<thorin::Continuation>()->params().back();
 }
 
 const thorin::Def* UnaryExpr::emit(Emitter& emitter) const {
@@ -1658,7 +1825,7 @@ const thorin::Def* StaticDecl::emit(Emitter& emitter) const {
     if (attrs) {
         if (auto export_attr = attrs->find("export")) {
             if (auto name_attr = export_attr->find("name"))
-                global->set_name(name_attr->as<LiteralAttr>()->lit.as_string());
+                global->set_name(std::string(name_attr->as<LiteralAttr>()->lit.as_string()));
             emitter.world.make_external(const_cast<thorin::Def*>(global));
         }
     }
@@ -1672,11 +1839,13 @@ const thorin::Def* FnDecl::emit(Emitter& emitter) const {
     Emitter::MonoFn mono_fn { this, {} };
     if (type_params) {
         for (auto& param : type_params->params)
-            mono_fn.type_args.push_back(param->type->replace(emitter.type_vars));
+            mono_fn.type_args.push_back(emitter.replace_type_vars(param->type));
         // Try to find an existing monomorphized version of this function with that type
         if (auto it = emitter.mono_fns.find(mono_fn); it != emitter.mono_fns.end())
             return it->second;
-        emitter.poly_defs.emplace_back();
+        // The nodes of the body are emitted in a fresh map, so as to allow
+        // multiple instantiations with different types.
+        emitter.instances.push_back(Emitter::Instance { this, {} });
         fn_type = type->as<artic::ForallType>()->body->as<artic::FnType>();
     } else {
         fn_type = type->as<artic::FnType>();
@@ -1692,12 +1861,12 @@ const thorin::Def* FnDecl::emit(Emitter& emitter) const {
     if (attrs) {
         if (auto export_attr = attrs->find("export")) {
             if (auto name_attr = export_attr->find("name"))
-                cont->set_name(name_attr->as<LiteralAttr>()->lit.as_string());
+                cont->set_name(std::string(name_attr->as<LiteralAttr>()->lit.as_string()));
             emitter.world.make_external(cont);
             cont->attributes().cc = thorin::CC::C;
         } else if (auto import_attr = attrs->find("import")) {
             if (auto name_attr = import_attr->find("name"))
-                cont->set_name(name_attr->as<LiteralAttr>()->lit.as_string());
+                cont->set_name(std::string(name_attr->as<LiteralAttr>()->lit.as_string()));
             if (auto cc_attr = import_attr->find("cc")) {
                 auto cc = cc_attr->as<LiteralAttr>()->lit.as_string();
                 if (cc == "device") {
@@ -1713,7 +1882,7 @@ const thorin::Def* FnDecl::emit(Emitter& emitter) const {
             }
         } else if (auto intern_attr = attrs->find("intern")) {
             if (auto name_attr = intern_attr->find("name"))
-                cont->set_name(name_attr->as<LiteralAttr>()->lit.as_string());
+                cont->set_name(std::string(name_attr->as<LiteralAttr>()->lit.as_string()));
             emitter.world.make_external(cont);
             cont->attributes().cc = thorin::CC::Thorin;
         }
@@ -1721,8 +1890,11 @@ const thorin::Def* FnDecl::emit(Emitter& emitter) const {
 
     if (fn->body) {
         // Set the IR node before entering the body, in case
-        // we encounter `return` or a recursive call.
-        fn->def = def = cont;
+        // we encounter `return` or a recursive call. Instances of
+        // polymorphic functions are found in `mono_fns` instead.
+        if (!type_params)
+            emitter.set_def(*this, cont);
+        emitter.set_def(*fn, cont);
 
         emitter.enter(cont);
         emitter.emit(*fn->param, emitter.tuple_from_params(cont, !fn_type->codom->isa<artic::NoRetType>()));
@@ -1732,15 +1904,8 @@ const thorin::Def* FnDecl::emit(Emitter& emitter) const {
         emitter.jump(cont->params().back(), value, emitter.debug_info(*fn->body));
     }
 
-    // Clear the thorin IR generated for this entire function
-    // if the function is polymorphic, so as to allow multiple
-    // instantiations with different types.
-    if (type_params) {
-        for (auto& def : emitter.poly_defs.back())
-            *def = nullptr;
-        emitter.poly_defs.pop_back();
-        fn->def = def = nullptr;
-    }
+    if (type_params)
+        emitter.instances.pop_back();
     return cont;
 }
 
@@ -1973,7 +2138,7 @@ inline std::string stringify_params(
 std::string StructType::stringify(Emitter& emitter) const {
     if (!type_params())
         return decl.id.name;
-    return stringify_params(emitter, decl.id.name + "_", type_params()->params);
+    return stringify_params(emitter, decl.id.name.str() + "_", type_params()->params);
 }
 
 const thorin::Type* StructType::convert(Emitter& emitter, const Type* parent) const {
@@ -1983,7 +2148,7 @@ const thorin::Type* StructType::convert(Emitter& emitter, const Type* parent) co
     emitter.types[parent] = type;
     for (size_t i = 0, n = decl.fields.size(); i < n; ++i) {
         type->set_op(i, decl.fields[i]->ast::Node::type->convert(emitter));
-        type->set_op_name(i, decl.fields[i]->id.name.empty() ? "_" + std::to_string(i) : decl.fields[i]->id.name);
+        type->set_op_name(i, decl.fields[i]->id.name.empty() ? "_" + std::to_string(i) : decl.fields[i]->id.name.str());
     }
     return type;
 }
@@ -1991,7 +2156,7 @@ const thorin::Type* StructType::convert(Emitter& emitter, const Type* parent) co
 std::string EnumType::stringify(Emitter& emitter) const {
     if (!decl.type_params)
         return decl.id.name;
-    return stringify_params(emitter, decl.id.name + "_", decl.type_params->params);
+    return stringify_params(emitter, decl.id.name.str() + "_", decl.type_params->params);
 }
 
 const thorin::Type* EnumType::convert(Emitter& emitter, const Type* parent) const {
@@ -2007,7 +2172,7 @@ const thorin::Type* EnumType::convert(Emitter& emitter, const Type* parent) cons
 }
 
 std::string TypeApp::stringify(Emitter& emitter) const {
-    auto map = replace(emitter.type_vars)->as<TypeApp>()->replace_map();
+    auto map = emitter.replace_type_vars(this)->as<TypeApp>()->replace_map();
     std::swap(emitter.type_vars, map);
     auto str = applied->stringify(emitter);
     std::swap(emitter.type_vars, map);
@@ -2016,7 +2181,7 @@ std::string TypeApp::stringify(Emitter& emitter) const {
 
 const thorin::Type* TypeApp::convert(Emitter& emitter) const {
     // Monomorphize this type by replacing bound type variables
-    auto mono_type = replace(emitter.type_vars)->as<TypeApp>();
+    auto mono_type = emitter.replace_type_vars(this)->as<TypeApp>();
     if (auto it = emitter.types.find(mono_type); it != emitter.types.end())
         return it->second;
 
@@ -2032,66 +2197,32 @@ const thorin::Type* TypeApp::convert(Emitter& emitter) const {
     return result;
 }
 
-// A read-only buffer from memory, not performing any copy.
-struct MemBuf : public std::streambuf {
-    MemBuf(const std::string& str) {
-        setg(
-            const_cast<char*>(str.data()),
-            const_cast<char*>(str.data()),
-            const_cast<char*>(str.data() + str.size()));
-    }
-
-    std::streampos seekoff(std::streamoff off, std::ios_base::seekdir way, std::ios_base::openmode) override {
-        if (way == std::ios_base::beg)
-            setg(eback(), eback() + off, egptr());
-        else if (way == std::ios_base::cur)
-            setg(eback(), gptr() + off, egptr());
-        else if (way == std::ios_base::end)
-            setg(eback(), egptr() + off, egptr());
-        else
-            return std::streampos(-1);
-        return gptr() - eback();
-    }
-
-    std::streampos seekpos(std::streampos pos, std::ios_base::openmode mode) override {
-        return seekoff(std::streamoff(pos), std::ios_base::beg, mode);
-    }
-
-    std::streamsize showmanyc() override {
-        return egptr() - gptr();
-    }
-};
-
 std::tuple<Ptr<ast::ModDecl>, bool> compile(
     const std::vector<std::string>& file_names,
-    const std::vector<std::string>& file_data,
+    const std::vector<std::string_view>& file_data,
     bool warns_as_errors,
     bool enable_all_warns,
+    bool debug,
+    bool print_match_stats,
     Arena& arena,
     TypeTable& type_table,
     thorin::World& world,
     Log& log)
 {
     assert(file_data.size() == file_names.size());
-    auto program = arena.make_ptr<ast::ModDecl>();
+    auto program = arena.make_ptr<ast::ModDecl>(arena);
     for (size_t i = 0, n = file_names.size(); i < n; ++i) {
         if (log.locator)
             log.locator->register_file(file_names[i], file_data[i]);
-        MemBuf mem_buf(file_data[i]);
-        std::istream is(&mem_buf);
-
-        Lexer lexer(log, file_names[i], is);
+        Lexer lexer(log, file_names[i], file_data[i], arena);
         Parser parser(log, lexer, arena);
         parser.warns_as_errors = warns_as_errors;
         auto module = parser.parse();
         if (log.errors > 0)
             return std::make_tuple(std::move(program), false);
 
-        program->decls.insert(
-            program->decls.end(),
-            std::make_move_iterator(module->decls.begin()),
-            std::make_move_iterator(module->decls.end())
-        );
+        for (auto& decl : module->decls)
+            program->decls.push_back(std::move(decl));
     }
 
     program->set_super();
@@ -2111,7 +2242,13 @@ std::tuple<Ptr<ast::ModDecl>, bool> compile(
 
     Emitter emitter(log, world, arena);
     emitter.warns_as_errors = warns_as_errors;
-    if (!emitter.run(*program))
+    emitter.debug = debug;
+    bool success = emitter.run(*program);
+    if (print_match_stats) {
+        log::format(log.out, "match statistics: {} decision tree node(s), {} shared\n",
+            emitter.match_stats.nodes, emitter.match_stats.shared_nodes);
+    }
+    if (!success)
         return std::make_tuple(std::move(program), false);
     return std::make_tuple(std::move(program), true);
 }
@@ -2129,7 +2266,15 @@ bool compile(
     Locator locator;
     log::Output out(error_stream, false);
     Log log(out, &locator);
-    Arena arena;
-    TypeTable type_table;
-    return get<1>(artic::compile(file_names, file_data, false, false, arena, type_table, world, log));
+    // The memory of the arena is kept from one compilation to the next, since
+    // the runtime system typically compiles many small programs in a row.
+    static thread_local Arena arena;
+    bool success = false;
+    {
+        TypeTable type_table;
+        std::vector<std::string_view> file_views(file_data.begin(), file_data.end());
+        success = get<1>(artic::compile(file_names, file_views, false, false, false, false, arena, type_table, world, log));
+    }
+    arena.reset();
+    return success;
 }
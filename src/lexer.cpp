@@ -1,51 +1,274 @@
 #include <utility>
 #include <algorithm>
+#include <iterator>
+#include <array>
+#include <bit>
 #include <cctype>
+#include <cstdint>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ARTIC_SCAN_SSE2
+#endif
 
 #include "artic/lexer.h"
 
 namespace artic {
 
-std::unordered_map<std::string, Token::Tag> Lexer::keywords{
-    std::make_pair("let",       Token::Let),
-    std::make_pair("mut",       Token::Mut),
-    std::make_pair("as",        Token::As),
-    std::make_pair("fn",        Token::Fn),
-    std::make_pair("if",        Token::If),
-    std::make_pair("else",      Token::Else),
-    std::make_pair("match",     Token::Match),
-    std::make_pair("while",     Token::While),
-    std::make_pair("for",       Token::For),
-    std::make_pair("in",        Token::In),
-    std::make_pair("break",     Token::Break),
-    std::make_pair("continue",  Token::Continue),
-    std::make_pair("return",    Token::Return),
-    std::make_pair("struct",    Token::Struct),
-    std::make_pair("enum",      Token::Enum),
-    std::make_pair("type",      Token::Type),
-    std::make_pair("implicit",  Token::Implicit),
-    std::make_pair("summon",    Token::Summon),
-    std::make_pair("static",    Token::Static),
-    std::make_pair("mod",       Token::Mod),
-    std::make_pair("use",       Token::Use),
-    std::make_pair("super",     Token::Super),
-    std::make_pair("asm",       Token::Asm),
-    std::make_pair("addrspace", Token::AddrSpace),
-    std::make_pair("simd",      Token::Simd)
+// Character scanners -----------------------------------------------------------------
+
+namespace scan {
+
+/// Classes of characters that the lexer can skip in bulk.
+/// All of them only contain ASCII characters that are not new lines.
+enum Class : uint8_t {
+    Blank        = 0x01, ///< White spaces, except new lines.
+    Ident        = 0x02, ///< Characters that can appear after the first character of an identifier.
+    Digit        = 0x04, ///< Decimal digits.
+    HexDigit     = 0x08, ///< Hexadecimal digits.
+    LineComment  = 0x10, ///< Characters that can appear in a line comment.
+    BlockComment = 0x20  ///< Characters that can appear in a block comment, except '*'.
 };
 
-Lexer::Lexer(Log& log, const std::string& filename, std::istream& is)
+static constexpr std::array<uint8_t, 256> classes = [] {
+    std::array<uint8_t, 256> table {};
+    for (int c = 0; c < 128; ++c) {
+        bool digit = c >= '0' && c <= '9';
+        bool alpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        if (c == ' ' || (c >= '\t' && c <= '\r' && c != '\n')) table[c] |= Blank;
+        if (digit || alpha || c == '_') table[c] |= Ident;
+        if (digit) table[c] |= Digit;
+        if (digit || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')) table[c] |= HexDigit;
+        if (c != '\n') table[c] |= LineComment;
+        if (c != '\n' && c != '*') table[c] |= BlockComment;
+    }
+    return table;
+}();
+
+inline bool is(Class cls, uint8_t c) { return (classes[c] & cls) != 0; }
+
+#if defined(__AVX2__) || defined(ARTIC_SCAN_SSE2)
+#define ARTIC_SCAN_SIMD
+
+#if defined(__AVX2__)
+struct Vec {
+    using Reg = __m256i;
+    static constexpr size_t size = 32;
+    static constexpr uint32_t all = 0xFFFFFFFF;
+    static Reg load(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const Reg*>(p)); }
+    static Reg splat(char c) { return _mm256_set1_epi8(c); }
+    static Reg eq(Reg a, Reg b) { return _mm256_cmpeq_epi8(a, b); }
+    static Reg gt(Reg a, Reg b) { return _mm256_cmpgt_epi8(a, b); }
+    static Reg or_(Reg a, Reg b) { return _mm256_or_si256(a, b); }
+    static Reg and_(Reg a, Reg b) { return _mm256_and_si256(a, b); }
+    static uint32_t mask(Reg a) { return uint32_t(_mm256_movemask_epi8(a)); }
+};
+#else
+struct Vec {
+    using Reg = __m128i;
+    static constexpr size_t size = 16;
+    static constexpr uint32_t all = 0xFFFF;
+    static Reg load(const char* p) { return _mm_loadu_si128(reinterpret_cast<const Reg*>(p)); }
+    static Reg splat(char c) { return _mm_set1_epi8(c); }
+    static Reg eq(Reg a, Reg b) { return _mm_cmpeq_epi8(a, b); }
+    static Reg gt(Reg a, Reg b) { return _mm_cmpgt_epi8(a, b); }
+    static Reg or_(Reg a, Reg b) { return _mm_or_si128(a, b); }
+    static Reg and_(Reg a, Reg b) { return _mm_and_si128(a, b); }
+    static uint32_t mask(Reg a) { return uint32_t(_mm_movemask_epi8(a)); }
+};
+#endif
+
+// Comparisons are signed: Bytes with the high bit set (i.e. non-ASCII) are negative,
+// and thus never fall in a range of ASCII characters.
+inline Vec::Reg in_range(Vec::Reg v, char lo, char hi) {
+    return Vec::and_(Vec::gt(v, Vec::splat(lo - 1)), Vec::gt(Vec::splat(hi + 1), v));
+}
+
+/// Returns a bit mask where each bit is set if the corresponding character is in the given class.
+template <Class C>
+inline uint32_t matches(Vec::Reg v) {
+    if constexpr (C == Blank) {
+        auto spaces = Vec::or_(Vec::eq(v, Vec::splat(' ')), in_range(v, '\t', '\r'));
+        return Vec::mask(spaces) & ~Vec::mask(Vec::eq(v, Vec::splat('\n')));
+    } else if constexpr (C == Ident || C == HexDigit) {
+        // Setting bit 5 maps upper case letters onto lower case ones
+        auto lower = Vec::or_(v, Vec::splat(0x20));
+        auto chars = C == Ident
+            ? Vec::or_(in_range(lower, 'a', 'z'), Vec::eq(v, Vec::splat('_')))
+            : in_range(lower, 'a', 'f');
+        return Vec::mask(Vec::or_(chars, in_range(v, '0', '9')));
+    } else if constexpr (C == Digit) {
+        return Vec::mask(in_range(v, '0', '9'));
+    } else if constexpr (C == LineComment) {
+        // The high bit of non-ASCII characters is already set
+        return ~Vec::mask(Vec::or_(v, Vec::eq(v, Vec::splat('\n'))));
+    } else {
+        auto stop = Vec::or_(Vec::eq(v, Vec::splat('\n')), Vec::eq(v, Vec::splat('*')));
+        return ~Vec::mask(Vec::or_(v, stop));
+    }
+}
+#endif // defined(__AVX2__) || defined(ARTIC_SCAN_SSE2)
+
+/// Returns a pointer to the first character in the given range that is not in the given class.
+template <Class C>
+const char* skip(const char* ptr, const char* end) {
+#ifdef ARTIC_SCAN_SIMD
+    for (; size_t(end - ptr) >= Vec::size; ptr += Vec::size) {
+        auto stop = ~matches<C>(Vec::load(ptr)) & Vec::all;
+        if (stop)
+            return ptr + std::countr_zero(stop);
+    }
+#endif
+    while (ptr != end && is(C, *ptr)) ptr++;
+    return ptr;
+}
+
+} // namespace scan
+
+// Keywords -----------------------------------------------------------------------------
+
+/// Perfect hash table containing the keywords of the language, built at compile time
+/// from the tokens in `TOKEN_TAGS` whose spelling is made of letters only.
+namespace keywords {
+
+static constexpr std::string_view spellings[] = {
+#define TAG(t, str) str,
+    TOKEN_TAGS(TAG)
+#undef TAG
+};
+
+static constexpr bool is_keyword(std::string_view str) {
+    if (str.empty())
+        return false;
+    for (auto c : str) {
+        if (c < 'a' || c > 'z')
+            return false;
+    }
+    return true;
+}
+
+static constexpr size_t table_size = 64;
+
+// Hashes the length and the first, second, and last characters of the given string.
+// Every keyword has at least two characters.
+static constexpr size_t hash(std::string_view str, uint32_t seed) {
+    uint32_t h = seed ^ uint32_t(str.size());
+    h = (h ^ uint8_t(str[0])) * 0x01000193;
+    h = (h ^ uint8_t(str[1])) * 0x01000193;
+    h = (h ^ uint8_t(str.back())) * 0x01000193;
+    return (h ^ (h >> 15)) & (table_size - 1);
+}
+
+struct Table {
+    std::array<uint8_t, table_size> tags {};
+    uint32_t seed = 0;
+    size_t min_size = std::numeric_limits<size_t>::max();
+    size_t max_size = 0;
+};
+
+// Searches for a seed for which the hash function has no collision on the set of keywords.
+static constexpr Table table = [] {
+    Table table;
+    for (auto str : spellings) {
+        if (is_keyword(str)) {
+            table.min_size = std::min(table.min_size, str.size());
+            table.max_size = std::max(table.max_size, str.size());
+        }
+    }
+    for (uint32_t seed = 0; seed < 0x10000; ++seed) {
+        table.tags.fill(Token::Id);
+        table.seed = seed;
+        bool collision = false;
+        for (size_t i = 0; i < std::size(spellings) && !collision; ++i) {
+            if (!is_keyword(spellings[i]))
+                continue;
+            auto& tag = table.tags[hash(spellings[i], seed)];
+            collision = tag != Token::Id;
+            tag = i;
+        }
+        if (!collision)
+            return table;
+    }
+    throw "no perfect hash function found for the keywords";
+}();
+
+static_assert(Token::End < 256);
+static_assert(table.min_size >= 2);
+
+/// Returns the tag of the keyword that corresponds to the given string, or `Token::Id` otherwise.
+static constexpr Token::Tag find(std::string_view str) {
+    if (str.size() < table.min_size || str.size() > table.max_size)
+        return Token::Id;
+    auto tag = Token::Tag(table.tags[hash(str, table.seed)]);
+    return spellings[tag] == str ? tag : Token::Id;
+}
+
+static_assert(find("let")       == Token::Let);
+static_assert(find("mut")       == Token::Mut);
+static_assert(find("as")        == Token::As);
+static_assert(find("fn")        == Token::Fn);
+static_assert(find("if")        == Token::If);
+static_assert(find("else")      == Token::Else);
+static_assert(find("match")     == Token::Match);
+static_assert(find("while")     == Token::While);
+static_assert(find("for")       == Token::For);
+static_assert(find("in")        == Token::In);
+static_assert(find("break")     == Token::Break);
+static_assert(find("continue")  == Token::Continue);
+static_assert(find("return")    == Token::Return);
+static_assert(find("struct")    == Token::Struct);
+static_assert(find("enum")      == Token::Enum);
+static_assert(find("type")      == Token::Type);
+static_assert(find("implicit")  == Token::Implicit);
+static_assert(find("summon")    == Token::Summon);
+static_assert(find("static")    == Token::Static);
+static_assert(find("mod")       == Token::Mod);
+static_assert(find("use")       == Token::Use);
+static_assert(find("super")     == Token::Super);
+static_assert(find("asm")       == Token::Asm);
+static_assert(find("addrspace") == Token::AddrSpace);
+static_assert(find("simd")      == Token::Simd);
+
+static_assert(find("")            == Token::Id);
+static_assert(find("l")           == Token::Id);
+static_assert(find("lets")        == Token::Id);
+static_assert(find("Let")         == Token::Id);
+static_assert(find("true")        == Token::Id);
+static_assert(find("false")       == Token::Id);
+static_assert(find("identifier")  == Token::Id);
+static_assert(find("addrspaces")  == Token::Id);
+static_assert(find("retrun")      == Token::Id);
+static_assert(find("<literal>")   == Token::Id);
+static_assert(find("<eof>")       == Token::Id);
+
+} // namespace keywords
+
+Lexer::Lexer(Log& log, const std::string& filename, std::istream& is, Arena& arena)
     : Logger(log)
-    , stream_(is)
-    , loc_(std::make_shared<std::string>(filename), { 1, 0 })
+    , buffer_(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>())
+    , arena_(arena)
+    , loc_(file_id(filename), { 1, 0 })
 {
-    // Read UTF-8 byte order mark (if any)
-    uint8_t bytes[] = { 0, 0, 0 };
-    stream_.read((char*)bytes, 3);
-    if (!utf8::is_bom(bytes)) {
-        stream_.clear();
-        stream_.seekg(0);
-    }
+    start(buffer_);
+}
+
+Lexer::Lexer(Log& log, const std::string& filename, std::string_view data, Arena& arena)
+    : Logger(log)
+    , arena_(arena)
+    , loc_(file_id(filename), { 1, 0 })
+{
+    start(data);
+}
+
+void Lexer::start(std::string_view data) {
+    ptr_ = data.data();
+    end_ = data.data() + data.size();
+    // Skip UTF-8 byte order mark (if any)
+    if (data.size() >= 3 && utf8::is_bom(reinterpret_cast<const uint8_t*>(ptr_)))
+        ptr_ += 3;
     eat();
 }
 
@@ -55,6 +278,7 @@ Token Lexer::next() {
 
         str_.clear();
         loc_.begin = loc_.end;
+        auto begin = cur_ptr();
 
         if (eof()) return Token(loc_, Token::End);
 
@@ -117,10 +341,7 @@ Token Lexer::next() {
         if (accept('/')) {
             // Handle comments here
             if (accept('*')) { eat_comments(); continue; }
-            if (accept('/')) {
-                while (!eof() && peek() != '\n') eat();
-                continue;
-            }
+            if (accept('/')) { eat_line_comment(); continue; }
             if (accept('=')) return Token(loc_, Token::DivEq);
             return Token(loc_, Token::Div);
         }
@@ -163,7 +384,7 @@ Token Lexer::next() {
                     }
                     if (is_nl)
                         error(loc_, "multiline character literals are not allowed");
-                    return Token(loc_, str_, Literal(uint8_t(str_[1])));
+                    return Token(loc_, spelling(begin, cur_ptr()), Literal(uint8_t(str_[1])));
                 }
             }
             error(loc_.at_begin().enlarge_after(), "unterminated character literal");
@@ -171,6 +392,7 @@ Token Lexer::next() {
         }
         if (accept('\"')) {
             Loc str_loc;
+            const char* str_end = nullptr;
             std::string str_lit;
             while (true) {
                 size_t pos = str_.size();
@@ -181,30 +403,32 @@ Token Lexer::next() {
                     return Token(loc_);
                 }
                 str_loc = loc_;
+                str_end = cur_ptr();
                 str_lit += str_.substr(pos, str_.size() - (pos + 1));
                 eat_spaces();
                 if (!accept('\"'))
                     break;
             }
             assert(str_.size() >= 2);
-            return Token(str_loc, str_, str_lit);
+            arena_vector<char> chars(arena_, str_lit.begin(), str_lit.end());
+            return Token(str_loc, spelling(begin, str_end), Literal(std::string_view(chars.data(), chars.size())));
         }
 
         if (std::isdigit(peek()) || peek() == '.') {
             auto lit = parse_literal();
-            return Token(loc_, str_, lit);
+            return Token(loc_, spelling(begin, cur_ptr()), lit);
         }
 
         if (std::isalpha(peek()) || peek() == '_') {
-            append();
-            while (std::isalnum(peek()) || peek() == '_') append();
+            skip_to(scan::skip<scan::Ident>(ptr_, end_));
+            auto str = spelling(begin, cur_ptr());
 
-            if (str_ == "true")  return Token(loc_, str_, true);
-            if (str_ == "false") return Token(loc_, str_, false);
+            if (str == "true")  return Token(loc_, str, true);
+            if (str == "false") return Token(loc_, str, false);
 
-            auto key_it = keywords.find(str_);
-            if (key_it == keywords.end()) return Token(loc_, str_);
-            return Token(loc_, key_it->second);
+            auto tag = keywords::find(str);
+            if (tag == Token::Id) return Token(loc_, Name(str));
+            return Token(loc_, tag);
         }
 
         append();
@@ -221,38 +445,63 @@ void Lexer::eat() {
         loc_.end.col++;
     }
 
-    cur_.bytes[0] = stream_.get();
-    cur_.size = eof() ? 0 : 1;
-    if (cur_.size > 0 && utf8::is_begin(cur_.bytes[0])) {
-        bool ok = true;
-        cur_.size = utf8::count_bytes(cur_.bytes[0]);
-        if (eof() || cur_.size < utf8::min_bytes() || cur_.size > utf8::max_bytes()) {
-            ok = false;
-            cur_.size = 1;
-        }
-        size_t read = 0;
-        for (size_t i = 1; i < cur_.size; ++i, ++read) {
-            uint8_t c = stream_.get();
-            ok &= !eof() && utf8::is_valid(c);
-            if (!ok)
-                break;
-            cur_.bytes[i] = c;
-        }
-        if (!ok) {
-            cur_.size = 1;
-            stream_.seekg(-std::streamoff(read), std::istream::cur); // Rollback read chars.
-            error(loc_.at_end().enlarge_after(), "invalid UTF-8 character");
-        }
+    if (ptr_ == end_) {
+        cur_.bytes[0] = 0;
+        cur_.size = 0;
+        return;
+    }
+    cur_.bytes[0] = *(ptr_++);
+    cur_.size = 1;
+    // Only multibyte characters need to go through the UTF-8 decoder
+    if (utf8::is_begin(cur_.bytes[0]))
+        eat_utf8();
+}
+
+void Lexer::eat_utf8() {
+    size_t n = utf8::count_bytes(cur_.bytes[0]);
+    bool ok = n >= utf8::min_bytes() && n <= utf8::max_bytes() && size_t(end_ - ptr_) >= n - 1;
+    for (size_t i = 1; ok && i < n; ++i)
+        ok = utf8::is_valid(ptr_[i - 1]);
+    if (!ok) {
+        error(loc_.at_end().enlarge_after(), "invalid UTF-8 character");
+        return;
     }
+    std::copy(ptr_, ptr_ + n - 1, cur_.bytes + 1);
+    cur_.size = n;
+    ptr_ += n - 1;
+}
+
+void Lexer::skip_to(const char* ptr) {
+    assert(!eof() && peek() != '\n' && ptr >= ptr_ && ptr <= end_);
+    loc_.end.col += ptr - ptr_;
+    ptr_ = ptr;
+    eat();
 }
 
 void Lexer::eat_spaces() {
-    while (!eof() && std::isspace(peek())) eat();
+    while (!eof() && std::isspace(peek())) {
+        if (peek() == '\n') {
+            eat();
+            continue;
+        }
+        skip_to(scan::skip<scan::Blank>(ptr_, end_));
+    }
+}
+
+void Lexer::eat_line_comment() {
+    while (!eof() && peek() != '\n')
+        skip_to(scan::skip<scan::LineComment>(ptr_, end_));
 }
 
 void Lexer::eat_comments() {
     while (true) {
-        while (!eof() && peek() != '*') eat();
+        while (!eof() && peek() != '*') {
+            if (peek() == '\n') {
+                eat();
+                continue;
+            }
+            skip_to(scan::skip<scan::BlockComment>(ptr_, end_));
+        }
         if (eof()) {
             error(loc_, "non-terminated multiline comment");
             return;
@@ -266,11 +515,10 @@ Literal Lexer::parse_literal() {
     int base = 10;
 
     auto parse_digits = [&] {
-        while (std::isdigit(peek()) ||
-               (base == 16 && peek() >= 'a' && peek() <= 'f') ||
-               (base == 16 && peek() >= 'A' && peek() <= 'F')) {
-            append();
-        }
+        if (base == 16 && !eof() && scan::is(scan::HexDigit, peek()))
+            append_to(scan::skip<scan::HexDigit>(ptr_, end_));
+        else if (base != 16 && !eof() && scan::is(scan::Digit, peek()))
+            append_to(scan::skip<scan::Digit>(ptr_, end_));
     };
 
     // Prefix starting with '0'
@@ -311,6 +559,12 @@ Literal Lexer::parse_literal() {
     return Literal(uint64_t(std::strtoull(digit_ptr, nullptr, base)));
 }
 
+void Lexer::append_to(const char* ptr) {
+    str_ += peek();
+    str_.append(ptr_, ptr);
+    skip_to(ptr);
+}
+
 void Lexer::append() {
     for (size_t i = 0; i < cur_.size; ++i)
         str_ += cur_.bytes[i];
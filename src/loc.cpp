@@ -0,0 +1,41 @@
+#include <unordered_map>
+#include <deque>
+#include <mutex>
+
+#include "artic/loc.h"
+
+namespace artic {
+
+struct FileTable {
+    std::mutex mutex;
+    // Elements of a deque are never moved when inserting at the end
+    std::deque<std::string> names;
+    std::unordered_map<std::string, FileId> ids;
+
+    FileTable() {
+        names.emplace_back("<unknown>");
+    }
+};
+
+static FileTable& file_table() {
+    static FileTable table;
+    return table;
+}
+
+FileId file_id(const std::string& name) {
+    auto& table = file_table();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto [it, inserted] = table.ids.emplace(name, table.names.size());
+    if (inserted)
+        table.names.emplace_back(name);
+    return it->second;
+}
+
+const std::string& file_name(FileId id) {
+    auto& table = file_table();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    assert(id < table.names.size());
+    return table.names[id];
+}
+
+} // namespace artic
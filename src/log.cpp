@@ -41,6 +41,23 @@ inline size_t count_digits(size_t i) {
     return n;
 }
 
+/// Part of a source line, displayed with TAB characters expanded into spaces.
+struct SourceText {
+    const char* begin;
+    const char* end;
+    size_t tab_width;
+};
+
+inline std::ostream& operator << (std::ostream& os, const SourceText& text) {
+    for (auto it = text.begin; it != text.end; ++it) {
+        if (*it == '\t')
+            os << log::fill(' ', text.tab_width);
+        else
+            os << *it;
+    }
+    return os;
+}
+
 void Logger::diagnostic(const Loc& loc, log::Style style, char underline) {
     if (!loc.file)
         return;
@@ -48,11 +65,14 @@ void Logger::diagnostic(const Loc& loc, log::Style style, char underline) {
     if (!diagnostics || !log.locator)
         return;
 
-    auto loc_info = log.locator->data(*loc.file);
+    auto loc_info = log.locator->data(loc.file);
     if (!loc_info || !loc_info->covers(loc))
         return;
 
     auto indent = 1 + count_digits(loc.end.row);
+    auto tab_width = log.locator->tab_width;
+    auto text  = [&] (const char* begin, const char* end) { return SourceText { begin, end, tab_width }; };
+    auto width = [&] (const char* begin, const char* end) { return loc_info->width(begin, end, tab_width); };
 
     auto begin_line     = loc_info->at(loc.begin.row, 1);
     auto begin_line_loc = loc_info->at(loc.begin.row, loc.begin.col);
@@ -67,35 +87,35 @@ void Logger::diagnostic(const Loc& loc, log::Style style, char underline) {
         log::fill(' ', indent - count_digits(loc.begin.row)),
         log::style(loc.begin.row, log::Style::White, log::Style::Bold),
         log::style('|', style, log::Style::Bold),
-        std::string_view(begin_line, begin_line_loc - begin_line)
+        text(begin_line, begin_line_loc)
     );
     bool multiline = loc.begin.row != loc.end.row;
     if (multiline) {
         log::format(log.out, "{}\n{} {}{}{}\n{}{}\n{}{} {}{}{}\n{} {}{}\n",
-            log::style(std::string_view(begin_line_loc, begin_line_end - begin_line_loc), style, log::Style::Bold),
+            log::style(text(begin_line_loc, begin_line_end), style, log::Style::Bold),
             log::fill(' ', indent),
             log::style('|', style, log::Style::Bold),
-            log::fill(' ', loc.begin.col - 1),
-            log::style(log::fill(underline, loc_info->line_size(loc.begin.row) + 1 - loc.begin.col), style, log::Style::Bold),
+            log::fill(' ', width(begin_line, begin_line_loc)),
+            log::style(log::fill(underline, width(begin_line_loc, begin_line_end)), style, log::Style::Bold),
             log::fill(' ', indent > 3 ? indent - 3 : 0),
             log::style("...", log::Style::White, log::Style::Bold),
             log::fill(' ', indent - count_digits(loc.end.row)),
             log::style(loc.end.row, log::Style::White, log::Style::Bold),
             log::style('|', style, log::Style::Bold),
-            log::style(std::string_view(end_line, end_line_loc - end_line), style, log::Style::Bold),
-            std::string_view(end_line_loc, end_line_end - end_line_loc),
+            log::style(text(end_line, end_line_loc), style, log::Style::Bold),
+            text(end_line_loc, end_line_end),
             log::fill(' ', indent),
             log::style('|', style, log::Style::Bold),
-            log::style(log::fill(underline, loc.end.col - 1), style, log::Style::Bold)
+            log::style(log::fill(underline, width(end_line, end_line_loc)), style, log::Style::Bold)
         );
     } else {
         log::format(log.out, "{}{}\n{} {}{}{}\n",
-            log::style(std::string_view(begin_line_loc, end_line_loc - begin_line_loc), style, log::Style::Bold),
-            std::string_view(end_line_loc, end_line_end - end_line_loc),
+            log::style(text(begin_line_loc, end_line_loc), style, log::Style::Bold),
+            text(end_line_loc, end_line_end),
             log::fill(' ', indent),
             log::style('|', style, log::Style::Bold),
-            log::fill(' ', loc.begin.col - 1),
-            log::style(log::fill(underline, loc.end.col - loc.begin.col), style, log::Style::Bold)
+            log::fill(' ', width(begin_line, begin_line_loc)),
+            log::style(log::fill(underline, width(begin_line_loc, end_line_loc)), style, log::Style::Bold)
         );
     }
 }
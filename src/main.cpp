@@ -1,13 +1,12 @@
 #include <vector>
 #include <string>
-#include <streambuf>
-#include <istream>
 #include <fstream>
 
 #include "artic/log.h"
 #include "artic/print.h"
 #include "artic/emit.h"
 #include "artic/locator.h"
+#include "artic/source.h"
 
 #include <thorin/world.h>
 #include <thorin/be/codegen.h>
@@ -47,6 +46,7 @@ static void usage() {
                 "         --show-implicit-casts  Shows implicit casts as comments when printing the AST\n"
                 "         --emit-thorin          Prints the Thorin IR after code generation\n"
                 "         --emit-c-interface     Emits C interface for exported functions and imported types\n"
+                "         --print-match-stats    Prints statistics about the decision trees generated for match expressions\n"
                 "         --log-level <lvl>      Changes the log level in Thorin (lvl = debug, verbose, info, warn, or error, defaults to error)\n"
                 "         --tab-width <n>        Sets the width of the TAB character in error messages or when printing the AST (in spaces, defaults to 2)\n"
                 "         --emit-c               Emits C code in the output file\n"
@@ -107,6 +107,7 @@ struct ProgramOptions {
     std::string host_attr;
     std::string hls_flags;
     bool show_implicit_casts = false;
+    bool print_match_stats = false;
     unsigned opt_level = 0;
     size_t max_errors = 0;
     size_t tab_width = 2;
@@ -164,6 +165,8 @@ struct ProgramOptions {
                     print_ast = true;
                 } else if (matches(argv[i], "--show-implicit-casts")) {
                     show_implicit_casts = true;
+                } else if (matches(argv[i], "--print-match-stats")) {
+                    print_match_stats = true;
                 } else if (matches(argv[i], "--emit-thorin")) {
                     emit_thorin = true;
                 } else if (matches(argv[i], "--emit-json")) {
@@ -257,33 +260,6 @@ struct ProgramOptions {
     }
 };
 
-static std::optional<std::string> read_file(const std::string& file) {
-    std::ifstream is(file);
-    if (!is)
-        return std::nullopt;
-    // Try/catch needed in case file is a directory (throws exception upon read)
-    try {
-        return std::make_optional(std::string(
-            std::istreambuf_iterator<char>(is),
-            std::istreambuf_iterator<char>()
-        ));
-    } catch (...) {
-        return std::nullopt;
-    }
-}
-
-static std::string tabs_to_spaces(const std::string& str, size_t indent) {
-    std::string res;
-    res.reserve(str.size());
-    for (auto c : str) {
-        size_t n = 1;
-        if (c == '\t')
-            n = indent, c = ' ';
-        res.append(n, c);
-    }
-    return res;
-}
-
 int main(int argc, char** argv) {
     ProgramOptions opts;
     if (!opts.parse(argc, argv))
@@ -303,19 +279,24 @@ int main(int argc, char** argv) {
         opts.module_name = file_without_ext(opts.files.front());
 
     Locator locator;
+    locator.tab_width = opts.tab_width;
     Log log(log::err, &locator);
     log.max_errors = opts.max_errors;
 
-    std::vector<std::string> file_data;
+    // Source files are kept alive until the end of the compilation,
+    // since the lexer and the locator refer to their contents.
+    std::vector<SourceFile> sources;
     for (auto& file : opts.files) {
-        // Tabs to spaces conversion is necessary in order to provide good error diagnostics.
-        auto data = read_file(file);
-        if (!data) {
+        auto source = SourceFile::open(file);
+        if (!source) {
             log::error("cannot open file '{}'", file);
             return EXIT_FAILURE;
         }
-        file_data.emplace_back(tabs_to_spaces(*data, opts.tab_width));
+        sources.emplace_back(std::move(*source));
     }
+    std::vector<std::string_view> file_data;
+    for (auto& source : sources)
+        file_data.emplace_back(source.data());
 
     thorin::Thorin thorin(opts.module_name);
     thorin.world().set(opts.log_level);
@@ -327,6 +308,8 @@ int main(int argc, char** argv) {
         opts.files, file_data,
         opts.warns_as_errors,
         opts.enable_all_warns,
+        opts.debug || opts.emit_thorin,
+        opts.print_match_stats,
         arena, type_table, thorin.world(), log);
 
     log.print_summary();
@@ -0,0 +1,50 @@
+#include <unordered_set>
+
+#include "artic/name.h"
+
+namespace artic {
+
+struct NamePool {
+    // Allows looking up string views without having to create an entry first
+    struct Hash {
+        using is_transparent = void;
+        size_t operator () (std::string_view str) const { return std::hash<std::string_view>()(str); }
+        size_t operator () (const Name::Entry& entry) const { return entry.hash; }
+    };
+
+    struct Equal {
+        using is_transparent = void;
+        bool operator () (const Name::Entry& a, const Name::Entry& b) const { return a.str == b.str; }
+        bool operator () (std::string_view a, const Name::Entry& b) const { return a == b.str; }
+        bool operator () (const Name::Entry& a, std::string_view b) const { return a.str == b; }
+    };
+
+    std::unordered_set<Name::Entry, Hash, Equal> entries;
+};
+
+// Every thread has its own pool, so that interning does not need any synchronization.
+// The pool is created on first use, so that names can be created during static initialization.
+static NamePool& name_pool() {
+    static thread_local NamePool pool;
+    return pool;
+}
+
+const Name::Entry& Name::empty_entry() {
+    static const Entry empty { std::string(), std::hash<std::string_view>()(std::string_view()) };
+    return empty;
+}
+
+Name::Name(std::string_view str) {
+    if (str.empty()) {
+        entry_ = &empty_entry();
+        return;
+    }
+    // Elements of an unordered set are never moved, even when it is rehashed
+    auto& pool = name_pool();
+    auto it = pool.entries.find(str);
+    if (it == pool.entries.end())
+        it = pool.entries.insert(Entry { std::string(str), std::hash<std::string_view>()(str) }).first;
+    entry_ = &*it;
+}
+
+} // namespace artic
@@ -17,7 +17,7 @@ Parser::Parser(Log& log, Lexer& lexer, Arena& arena)
 
 Ptr<ast::ModDecl> Parser::parse() {
     Tracker tracker(this);
-    PtrVector<ast::Decl> decls;
+    PtrVector<ast::Decl> decls(_arena);
     while (ahead().tag() != Token::End)
         decls.emplace_back(parse_decl(true));
     return _arena.make_ptr<ast::ModDecl>(tracker(), ast::Identifier(), std::move(decls));
@@ -112,7 +112,7 @@ Ptr<ast::FnDecl> Parser::parse_fn_decl() {
 
 Ptr<ast::FieldDecl> Parser::parse_field_decl(bool is_tuple_like) {
     Tracker tracker(this);
-    auto id = is_tuple_like ? ast::Identifier(tracker(), "") : parse_id();
+    auto id = is_tuple_like ? ast::Identifier(tracker(), Name()) : parse_id();
     if (!is_tuple_like)
         expect(Token::Colon);
     auto type = parse_type();
@@ -131,7 +131,7 @@ Ptr<ast::StructDecl> Parser::parse_struct_decl() {
     if (ahead().tag() == Token::LBracket)
         type_params = parse_type_params();
 
-    PtrVector<ast::FieldDecl> fields;
+    PtrVector<ast::FieldDecl> fields(_arena);
     bool is_tuple_like = accept(Token::LParen);
     if (is_tuple_like || accept(Token::LBrace)) {
         accept(Token::LBrace);
@@ -153,7 +153,7 @@ Ptr<ast::OptionDecl> Parser::parse_option_decl() {
     auto id = parse_id();
 
     Ptr<ast::Type> param;
-    PtrVector<ast::FieldDecl> fields;
+    PtrVector<ast::FieldDecl> fields(_arena);
     bool has_fields = false;
     if (ahead().tag() == Token::LParen) {
         param = parse_tuple_type();
@@ -175,7 +175,7 @@ Ptr<ast::EnumDecl> Parser::parse_enum_decl() {
     if (ahead().tag() == Token::LBracket)
         type_params = parse_type_params();
 
-    PtrVector<ast::OptionDecl> options;
+    PtrVector<ast::OptionDecl> options(_arena);
     expect(Token::LBrace);
     parse_list(Token::RBrace, Token::Comma, [&] {
         options.emplace_back(parse_option_decl());
@@ -240,7 +240,7 @@ Ptr<ast::TypeParam> Parser::parse_type_param() {
 Ptr<ast::TypeParamList> Parser::parse_type_params() {
     Tracker tracker(this);
     eat(Token::LBracket);
-    PtrVector<ast::TypeParam> type_params;
+    PtrVector<ast::TypeParam> type_params(_arena);
     parse_list(Token::RBracket, Token::Comma, [&] {
         type_params.emplace_back(parse_type_param());
     });
@@ -251,7 +251,7 @@ Ptr<ast::ModDecl> Parser::parse_mod_decl() {
     Tracker tracker(this);
     eat(Token::Mod);
     auto id = parse_id();
-    PtrVector<ast::Decl> decls;
+    PtrVector<ast::Decl> decls(_arena);
     expect(Token::LBrace);
     while (ahead().tag() != Token::End && ahead().tag() != Token::RBrace)
         decls.emplace_back(parse_decl(true));
@@ -381,7 +381,7 @@ Ptr<ast::FieldPtrn> Parser::parse_field_ptrn() {
     ast::Identifier id;
     Ptr<ast::Ptrn> ptrn;
     if (ahead().tag() == Token::Dots) {
-        id.name = "...";
+        id.name = Name("...");
         id.loc = ahead().loc();
         eat(Token::Dots);
     } else {
@@ -395,7 +395,7 @@ Ptr<ast::FieldPtrn> Parser::parse_field_ptrn() {
 Ptr<ast::RecordPtrn> Parser::parse_record_ptrn(ast::Path&& path) {
     Tracker tracker(this, path.loc);
     eat(Token::LBrace);
-    PtrVector<ast::FieldPtrn> fields;
+    PtrVector<ast::FieldPtrn> fields(_arena);
     parse_list(Token::RBrace, Token::Comma, [&] {
         fields.emplace_back(parse_field_ptrn());
     });
@@ -417,7 +417,7 @@ Ptr<ast::CtorPtrn> Parser::parse_ctor_ptrn(ast::Path&& path) {
 Ptr<ast::Ptrn> Parser::parse_tuple_ptrn(bool allow_types, bool allow_implicits, Token::Tag beg, Token::Tag end) {
     Tracker tracker(this);
     eat(beg);
-    PtrVector<ast::Ptrn> args;
+    PtrVector<ast::Ptrn> args(_arena);
     parse_list(end, Token::Comma, [&] {
         args.emplace_back(parse_ptrn(allow_types, allow_implicits));
     });
@@ -432,7 +432,7 @@ Ptr<ast::ArrayPtrn> Parser::parse_array_ptrn() {
     Tracker tracker(this);
     bool is_simd = accept(Token::Simd);
     eat(Token::LBracket);
-    PtrVector<ast::Ptrn> elems;
+    PtrVector<ast::Ptrn> elems(_arena);
     parse_list(Token::RBracket, Token::Comma, [&] {
         elems.emplace_back(parse_ptrn());
     });
@@ -525,7 +525,7 @@ Ptr<ast::RecordExpr> Parser::parse_record_expr(ast::Path&& path) {
     auto loc = path.loc;
     auto type_app = _arena.make_ptr<ast::TypeApp>(loc, std::move(path));
     eat(Token::LBrace);
-    PtrVector<ast::FieldExpr> fields;
+    PtrVector<ast::FieldExpr> fields(_arena);
     parse_list(Token::RBrace, Token::Comma, [&] {
         fields.emplace_back(parse_field_expr());
     });
@@ -536,7 +536,7 @@ Ptr<ast::RecordExpr> Parser::parse_record_expr(Ptr<ast::Expr>&& expr) {
     Tracker tracker(this, expr->loc);
     eat(Token::Dot);
     eat(Token::LBrace);
-    PtrVector<ast::FieldExpr> fields;
+    PtrVector<ast::FieldExpr> fields(_arena);
     parse_list(Token::RBrace, Token::Comma, [&] {
         fields.emplace_back(parse_field_expr());
     });
@@ -546,7 +546,7 @@ Ptr<ast::RecordExpr> Parser::parse_record_expr(Ptr<ast::Expr>&& expr) {
 Ptr<ast::Expr> Parser::parse_tuple_expr() {
     Tracker tracker(this);
     eat(Token::LParen);
-    PtrVector<ast::Expr> args;
+    PtrVector<ast::Expr> args(_arena);
     parse_list(Token::RParen, Token::Comma, [&] {
         args.emplace_back(parse_expr());
     });
@@ -561,7 +561,7 @@ Ptr<ast::Expr> Parser::parse_array_expr() {
     Tracker tracker(this);
     bool is_simd = accept(Token::Simd);
     expect(Token::LBracket);
-    PtrVector<ast::Expr> elems;
+    PtrVector<ast::Expr> elems(_arena);
     elems.emplace_back(parse_expr());
     if (accept(Token::Semi)) {
         auto size = parse_array_size();
@@ -583,7 +583,7 @@ Ptr<ast::Expr> Parser::parse_array_expr() {
 Ptr<ast::BlockExpr> Parser::parse_block_expr() {
     Tracker tracker(this);
     eat(Token::LBrace);
-    PtrVector<ast::Stmt> stmts;
+    PtrVector<ast::Stmt> stmts(_arena);
     bool last_semi = false;
     while (true) {
         switch (ahead().tag()) {
@@ -645,7 +645,7 @@ Ptr<ast::FnExpr> Parser::parse_fn_expr(Ptr<ast::Filter>&& filter, bool nested) {
     if (ahead().tag() == Token::Or || nested) {
         if (!nested) eat(Token::Or);
 
-        PtrVector<ast::Ptrn> args;
+        PtrVector<ast::Ptrn> args(_arena);
         parse_nested = parse_list(
             std::array<Token::Tag, 2>{ Token::Or, Token::LogicOr },
             std::array<Token::Tag, 1>{ Token::Comma }, [&] {
@@ -740,7 +740,7 @@ Ptr<ast::MatchExpr> Parser::parse_match_expr() {
     eat(Token::Match);
     auto arg = parse_expr(false);
     expect(Token::LBrace);
-    PtrVector<ast::CaseExpr> cases;
+    PtrVector<ast::CaseExpr> cases(_arena);
     parse_list(Token::RBrace, Token::Comma, [&] {
         cases.emplace_back(parse_case_expr());
     });
@@ -1053,7 +1053,7 @@ Ptr<ast::PrimType> Parser::parse_prim_type(ast::PrimType::Tag tag) {
 Ptr<ast::Type> Parser::parse_tuple_type() {
     Tracker tracker(this);
     eat(Token::LParen);
-    PtrVector<ast::Type> args;
+    PtrVector<ast::Type> args(_arena);
     parse_list(Token::RParen, Token::Comma, [&] {
         args.emplace_back(parse_type());
     });
@@ -1144,7 +1144,7 @@ Ptr<ast::AttrList> Parser::parse_attr_list() {
     Tracker tracker(this);
     eat(Token::Hash);
     expect(Token::LBracket);
-    PtrVector<ast::Attr> attrs;
+    PtrVector<ast::Attr> attrs(_arena);
     parse_list(Token::RBracket, Token::Comma, [&] {
         attrs.emplace_back(parse_attr());
     });
@@ -1153,7 +1153,7 @@ Ptr<ast::AttrList> Parser::parse_attr_list() {
 
 Ptr<ast::Attr> Parser::parse_attr() {
     Tracker tracker(this);
-    std::string name;
+    Name name;
     if (ahead().tag() == Token::Id)
         name = ahead().identifier();
     expect(Token::Id);
@@ -1162,32 +1162,32 @@ Ptr<ast::Attr> Parser::parse_attr() {
         if (ahead().tag() == Token::Lit) {
             auto lit = ahead().literal();
             eat(Token::Lit);
-            return _arena.make_ptr<ast::LiteralAttr>(tracker(), std::move(name), lit);
+            return _arena.make_ptr<ast::LiteralAttr>(tracker(), name, lit);
         } else if (ahead().tag() == Token::Id) {
             auto path = parse_path();
-            return _arena.make_ptr<ast::PathAttr>(tracker(), std::move(name), std::move(path));
+            return _arena.make_ptr<ast::PathAttr>(tracker(), name, std::move(path));
         } else {
             error(ahead().loc(), "expected attribute value, got '{}'", ahead().string());
-            return _arena.make_ptr<ast::NamedAttr>(tracker(), std::move(name), PtrVector<ast::Attr>());
+            return _arena.make_ptr<ast::NamedAttr>(tracker(), name, PtrVector<ast::Attr>());
         }
     } else {
-        PtrVector<ast::Attr> args;
+        PtrVector<ast::Attr> args(_arena);
         if (accept(Token::LParen)) {
             parse_list(Token::RParen, Token::Comma, [&] {
                 args.emplace_back(parse_attr());
             });
         }
-        return _arena.make_ptr<ast::NamedAttr>(tracker(), std::move(name), std::move(args));
+        return _arena.make_ptr<ast::NamedAttr>(tracker(), name, std::move(args));
     }
 }
 
 ast::Path Parser::parse_path(ast::Identifier&& id, bool allow_types) {
     Tracker tracker(this, id.loc);
 
-    std::vector<ast::Path::Elem> elems;
+    arena_vector<ast::Path::Elem> elems(_arena);
     do {
         Tracker elem_tracker(this, id.loc);
-        PtrVector<ast::Type> args;
+        PtrVector<ast::Type> args(_arena);
         // Do not accept type arguments on `super`
         if (allow_types && id.name != "super" && accept(Token::LBracket)) {
             parse_list(Token::RBracket, Token::Comma, [&] {
@@ -1205,18 +1205,18 @@ ast::Path Parser::parse_path(ast::Identifier&& id, bool allow_types) {
 
 ast::Identifier Parser::parse_path_elem() {
     auto prev_loc = ahead().loc();
-    return accept(Token::Super) ? ast::Identifier(prev_loc, "super") : parse_id();
+    return accept(Token::Super) ? ast::Identifier(prev_loc, Name("super")) : parse_id();
 }
 
 ast::Identifier Parser::parse_id() {
     Tracker tracker(this);
-    std::string ident;
+    Name ident;
     if (ahead().is_identifier())
         ident = ahead().identifier();
     else
         error(ahead().loc(), "expected identifier, got '{}'", ahead().string());
     next();
-    return ast::Identifier(tracker(), std::move(ident));
+    return ast::Identifier(tracker(), ident);
 }
 
 ast::AsmExpr::Constr Parser::parse_constr() {
@@ -0,0 +1,81 @@
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+#include "artic/source.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace artic {
+
+SourceFile::SourceFile(SourceFile&& other)
+    : map_(std::exchange(other.map_, nullptr))
+    , map_size_(std::exchange(other.map_size_, 0))
+    , buffer_(std::move(other.buffer_))
+{}
+
+SourceFile::~SourceFile() {
+    unmap();
+}
+
+SourceFile& SourceFile::operator = (SourceFile&& other) {
+    unmap();
+    map_      = std::exchange(other.map_, nullptr);
+    map_size_ = std::exchange(other.map_size_, 0);
+    buffer_   = std::move(other.buffer_);
+    return *this;
+}
+
+void SourceFile::unmap() {
+#ifndef _WIN32
+    if (map_)
+        munmap(map_, map_size_);
+#endif
+    map_ = nullptr;
+    map_size_ = 0;
+}
+
+std::optional<SourceFile> SourceFile::open(const std::string& file) {
+    SourceFile source;
+#ifndef _WIN32
+    int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0)
+        return std::nullopt;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || S_ISDIR(info.st_mode)) {
+        close(fd);
+        return std::nullopt;
+    }
+    if (S_ISREG(info.st_mode) && info.st_size > 0) {
+        auto map = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            close(fd);
+            source.map_ = map;
+            source.map_size_ = info.st_size;
+            return std::make_optional(std::move(source));
+        }
+    }
+    close(fd);
+#endif
+
+    // Fallback for pipes, empty files, or when mapping the file is not possible
+    std::ifstream is(file, std::ios::binary);
+    if (!is)
+        return std::nullopt;
+    // Try/catch needed in case file is a directory (throws exception upon read)
+    try {
+        source.buffer_.assign(
+            std::istreambuf_iterator<char>(is),
+            std::istreambuf_iterator<char>());
+    } catch (...) {
+        return std::nullopt;
+    }
+    return std::make_optional(std::move(source));
+}
+
+} // namespace artic
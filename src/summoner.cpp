@@ -10,32 +10,22 @@ bool Summoner::run(ast::ModDecl& mod) {
 }
 
 void Summoner::push_scope() {
-    scopes.emplace(scopes.begin());
+    implicits.push_scope();
 }
 
 void Summoner::pop_scope() {
-    assert(!scopes.empty());
-    scopes.erase(scopes.begin());
+    implicits.pop_scope();
 }
 
 void Summoner::insert(const artic::Type* t, const ast::Expr* e) {
-    assert(!scopes.empty());
-    auto& scope = scopes[0];
-    auto existing = scope.find(t);
-    if (existing != scope.end()) {
+    if (!implicits.insert(t, e))
         log::error("Ambiguity: two different implicit declarations for {} given in scope", *t);
-        return;
-    }
-    scope.emplace(t, e);
 }
 
 const ast::Expr* Summoner::resolve(const artic::Type* t, const artic::Loc& at) {
-    for (auto& scope : scopes) {
-        auto found = scope.find(t);
-        if (found != scope.end())
-            return found->second;
-        // TODO: use subtyping relations and generators
-    }
+    // TODO: use subtyping relations and generators
+    if (auto expr = implicits.find(t))
+        return *expr;
     error = true;
     log::error("Could not summon an implicit value of type {} at {}", *t, at);
     return nullptr;
@@ -1,4 +1,3 @@
-#include <typeinfo>
 #include <algorithm>
 
 #include "artic/types.h"
@@ -22,121 +21,112 @@ TypeBounds& TypeBounds::meet(const TypeBounds& bounds) {
 // Equals ---------------------------------------------------------------------------
 
 bool PrimType::equals(const Type* other) const {
-    return other->isa<PrimType>() && other->as<PrimType>()->tag == tag;
+    return other->as<PrimType>()->tag == tag;
 }
 
 bool TupleType::equals(const Type* other) const {
-    return other->isa<TupleType>() && other->as<TupleType>()->args == args;
+    return other->as<TupleType>()->args == args;
 }
 
 bool SizedArrayType::equals(const Type* other) const {
     return
-        other->isa<SizedArrayType>() &&
         other->as<SizedArrayType>()->elem == elem &&
         other->as<SizedArrayType>()->size == size &&
         other->as<SizedArrayType>()->is_simd == is_simd;
 }
 
 bool UnsizedArrayType::equals(const Type* other) const {
-    return
-        other->isa<UnsizedArrayType>() &&
-        other->as<UnsizedArrayType>()->elem == elem;
+    return other->as<UnsizedArrayType>()->elem == elem;
 }
 
 bool AddrType::equals(const Type* other) const {
     return
-        typeid(*other) == typeid(*this) &&
-        other->isa<AddrType>() &&
         other->as<AddrType>()->pointee == pointee &&
         other->as<AddrType>()->addr_space == addr_space &&
         other->as<AddrType>()->is_mut == is_mut;
 }
 
 bool ImplicitParamType::equals(const artic::Type* other) const {
-    return
-        other->isa<ImplicitParamType>() &&
-        other->as<ImplicitParamType>()->underlying == underlying;
+    return other->as<ImplicitParamType>()->underlying == underlying;
 }
 
 bool FnType::equals(const Type* other) const {
     return
-        other->isa<FnType>() &&
         other->as<FnType>()->dom == dom &&
         other->as<FnType>()->codom == codom;
 }
 
-bool BottomType::equals(const Type* other) const {
-    return typeid(*other) == typeid(*this);
+bool BottomType::equals(const Type*) const {
+    return true;
 }
 
-bool TopType::equals(const Type* other) const {
-    return typeid(*other) == typeid(*this);
+bool TopType::equals(const Type*) const {
+    return true;
 }
 
 bool TypeApp::equals(const Type* other) const {
     return
-        other->isa<TypeApp>() &&
         other->as<TypeApp>()->applied == applied &&
         other->as<TypeApp>()->type_args == type_args;
 }
 
 // Hash ----------------------------------------------------------------------------
 
-size_t PrimType::hash() const {
-    return fnv::Hash().combine(typeid(*this).hash_code()).combine(tag);
+size_t PrimType::compute_hash() const {
+    return fnv::Hash().combine(kind).combine(tag);
 }
 
-size_t TupleType::hash() const {
-    auto h = fnv::Hash().combine(typeid(*this).hash_code());
+size_t TupleType::compute_hash() const {
+    auto h = fnv::Hash().combine(kind);
     for (auto a : args)
         h.combine(a);
     return h;
 }
 
-size_t SizedArrayType::hash() const {
+size_t SizedArrayType::compute_hash() const {
     return fnv::Hash()
-        .combine(typeid(*this).hash_code())
+        .combine(kind)
         .combine(elem)
         .combine(size)
         .combine(is_simd);
 }
 
-size_t UnsizedArrayType::hash() const {
+size_t UnsizedArrayType::compute_hash() const {
     return fnv::Hash()
-        .combine(typeid(*this).hash_code())
+        .combine(kind)
         .combine(elem);
 }
 
-size_t AddrType::hash() const {
+size_t AddrType::compute_hash() const {
     return fnv::Hash()
-        .combine(typeid(*this).hash_code())
+        .combine(kind)
         .combine(pointee)
         .combine(is_mut);
 }
 
-size_t ImplicitParamType::hash() const {
+size_t ImplicitParamType::compute_hash() const {
     return fnv::Hash()
-        .combine(typeid(*this).hash_code())
+        .combine(kind)
         .combine(underlying);
 }
 
-size_t FnType::hash() const {
+size_t FnType::compute_hash() const {
     return fnv::Hash()
-        .combine(typeid(*this).hash_code())
+        .combine(kind)
         .combine(dom)
         .combine(codom);
 }
 
-size_t BottomType::hash() const {
-    return fnv::Hash().combine(typeid(*this).hash_code());
+size_t BottomType::compute_hash() const {
+    return fnv::Hash().combine(kind);
 }
 
-size_t TopType::hash() const {
-    return fnv::Hash().combine(typeid(*this).hash_code());
+size_t TopType::compute_hash() const {
+    return fnv::Hash().combine(kind);
 }
 
-size_t TypeApp::hash() const {
-    auto h = fnv::Hash().combine(typeid(*this).hash_code()).combine(applied);
+size_t TypeApp::compute_hash() const {
+    auto h = fnv::Hash().combine(kind).combine(applied);
     for (auto a : type_args)
         h.combine(a);
     return h;
@@ -179,26 +169,26 @@ bool TypeApp::contains(const Type* type) const {
 
 // Replace -------------------------------------------------------------------------
 
-const Type* TupleType::replace(const std::unordered_map<const TypeVar*, const Type*>& map) const {
+const Type* TupleType::replace(const ReplaceMap& map) const {
     SmallArray<const Type*> new_args(args.size());
     for (size_t i = 0, n = args.size(); i < n; ++i)
         new_args[i] = args[i]->replace(map);
     return type_table.tuple_type(std::move(new_args));
 }
 
-const Type* SizedArrayType::replace(const std::unordered_map<const TypeVar*, const Type*>& map) const {
+const Type* SizedArrayType::replace(const ReplaceMap& map) const {
     return type_table.sized_array_type(elem->replace(map), size, is_simd);
 }
 
-const Type* UnsizedArrayType::replace(const std::unordered_map<const TypeVar*, const Type*>& map) const {
+const Type* UnsizedArrayType::replace(const ReplaceMap& map) const {
     return type_table.unsized_array_type(elem->replace(map));
 }
 
-const Type* PtrType::replace(const std::unordered_map<const TypeVar*, const Type*>& map) const {
+const Type* PtrType::replace(const ReplaceMap& map) const {
     return type_table.ptr_type(pointee->replace(map), is_mut, addr_space);
 }
 
-const Type* RefType::replace(const std::unordered_map<const TypeVar*, const Type*>& map) const {
+const Type* RefType::replace(const ReplaceMap& map) const {
     return type_table.ref_type(pointee->replace(map), is_mut, addr_space);
 }
 
@@ -206,17 +196,17 @@ const Type* ImplicitParamType::replace(const artic::ReplaceMap& map) const {
     return type_table.implicit_param_type(underlying->replace(map));
 }
 
-const Type* FnType::replace(const std::unordered_map<const TypeVar*, const Type*>& map) const {
+const Type* FnType::replace(const ReplaceMap& map) const {
     return type_table.fn_type(dom->replace(map), codom->replace(map));
 }
 
-const Type* TypeVar::replace(const std::unordered_map<const TypeVar*, const Type*>& map) const {
+const Type* TypeVar::replace(const ReplaceMap& map) const {
     if (auto it = map.find(this); it != map.end())
         return it->second;
     return this;
 }
 
-const Type* TypeApp::replace(const std::unordered_map<const TypeVar*, const Type*>& map) const {
+const Type* TypeApp::replace(const ReplaceMap& map) const {
     SmallArray<const Type*> new_type_args(type_args.size());
     for (size_t i = 0, n = type_args.size(); i < n; ++i)
         new_type_args[i] = type_args[i]->replace(map);
@@ -270,22 +260,31 @@ size_t TypeApp::order(std::unordered_set<const Type*>& seen) const {
 
 // Variance ------------------------------------------------------------------------
 
-void Type::variance(std::unordered_map<const TypeVar*, TypeVariance>&, bool) const {}
+const TypeVarMap<TypeVariance>& Type::variance(bool dir) const {
+    auto& cache = type_table.variance_cache_[dir ? 1 : 0];
+    if (auto it = cache.find(this); it != cache.end())
+        return it->second;
+    TypeVarMap<TypeVariance> vars;
+    variance(vars, dir);
+    return cache.emplace(this, std::move(vars)).first->second;
+}
 
-void TupleType::variance(std::unordered_map<const TypeVar*, TypeVariance>& vars, bool dir) const {
+void Type::variance(TypeVarMap<TypeVariance>&, bool) const {}
+
+void TupleType::variance(TypeVarMap<TypeVariance>& vars, bool dir) const {
     for (auto arg : args)
         arg->variance(vars, dir);
 }
 
-void ArrayType::variance(std::unordered_map<const TypeVar*, TypeVariance>& vars, bool dir) const {
+void ArrayType::variance(TypeVarMap<TypeVariance>& vars, bool dir) const {
     elem->variance(vars, dir);
 }
 
-void AddrType::variance(std::unordered_map<const TypeVar*, TypeVariance>& vars, bool dir) const {
+void AddrType::variance(TypeVarMap<TypeVariance>& vars, bool dir) const {
     pointee->variance(vars, dir);
 }
 
-void FnType::variance(std::unordered_map<const TypeVar*, TypeVariance>& vars, bool dir) const {
+void FnType::variance(TypeVarMap<TypeVariance>& vars, bool dir) const {
     dom->variance(vars, !dir);
     codom->variance(vars, dir);
 }
@@ -294,7 +293,7 @@ void ImplicitParamType::variance(TypeVarMap<artic::TypeVariance>& vars, bool dir
     return underlying->variance(vars, dir);
 }
 
-void TypeVar::variance(std::unordered_map<const TypeVar*, TypeVariance>& vars, bool dir) const {
+void TypeVar::variance(TypeVarMap<TypeVariance>& vars, bool dir) const {
     if (auto it = vars.find(this); it != vars.end()) {
         bool var_dir = it->second == TypeVariance::Covariant ? true : false;
         if (var_dir != dir)
@@ -303,28 +302,28 @@ void TypeVar::variance(std::unordered_map<const TypeVar*, TypeVariance>& vars, b
         vars.emplace(this, dir ? TypeVariance::Covariant : TypeVariance::Contravariant);
 }
 
-void TypeApp::variance(std::unordered_map<const TypeVar*, TypeVariance>& vars, bool dir) const {
+void TypeApp::variance(TypeVarMap<TypeVariance>& vars, bool dir) const {
     for (auto type_arg : type_args)
         type_arg->variance(vars, dir);
 }
 
 // Bounds --------------------------------------------------------------------------
 
-void Type::bounds(std::unordered_map<const TypeVar*, TypeBounds>&, const Type*, bool) const {}
+void Type::bounds(TypeVarMap<TypeBounds>&, const Type*, bool) const {}
 
-void TupleType::bounds(std::unordered_map<const TypeVar*, TypeBounds>& bounds, const Type* type, bool dir) const {
+void TupleType::bounds(TypeVarMap<TypeBounds>& bounds, const Type* type, bool dir) const {
     if (auto tuple_type = type->isa<TupleType>()) {
         for (size_t i = 0, n = std::min(args.size(), tuple_type->args.size()); i < n; ++i)
             args[i]->bounds(bounds, tuple_type->args[i], dir);
     }
 }
 
-void ArrayType::bounds(std::unordered_map<const TypeVar*, TypeBounds>& bounds, const Type* type, bool dir) const {
+void ArrayType::bounds(TypeVarMap<TypeBounds>& bounds, const Type* type, bool dir) const {
     if (auto array_type = type->isa<ArrayType>())
         elem->bounds(bounds, array_type->elem, dir);
 }
 
-void AddrType::bounds(std::unordered_map<const TypeVar*, TypeBounds>& bounds, const Type* type, bool dir) const {
+void AddrType::bounds(TypeVarMap<TypeBounds>& bounds, const Type* type, bool dir) const {
     if (auto addr_type = type->isa<AddrType>())
         pointee->bounds(bounds, addr_type->pointee, dir);
 }
@@ -333,14 +332,14 @@ void ImplicitParamType::bounds(TypeVarMap<artic::TypeBounds>& bounds, const arti
     underlying->bounds(bounds, type, dir);
 }
 
-void FnType::bounds(std::unordered_map<const TypeVar*, TypeBounds>& bounds, const Type* type, bool dir) const {
+void FnType::bounds(TypeVarMap<TypeBounds>& bounds, const Type* type, bool dir) const {
     if (auto fn_type = type->isa<FnType>()) {
         dom->bounds(bounds, fn_type->dom, !dir);
         codom->bounds(bounds, fn_type->codom, dir);
     }
 }
 
-void TypeVar::bounds(std::unordered_map<const TypeVar*, TypeBounds>& bounds, const Type* type, bool dir) const {
+void TypeVar::bounds(TypeVarMap<TypeBounds>& bounds, const Type* type, bool dir) const {
     TypeBounds type_bounds;
     if (dir)
         type_bounds = TypeBounds { type, type_table.top_type() };
@@ -353,7 +352,7 @@ void TypeVar::bounds(std::unordered_map<const TypeVar*, TypeBounds>& bounds, con
         bounds[this] = type_bounds;
 }
 
-void TypeApp::bounds(std::unordered_map<const TypeVar*, TypeBounds>& bounds, const Type* type, bool dir) const {
+void TypeApp::bounds(TypeVarMap<TypeBounds>& bounds, const Type* type, bool dir) const {
     if (auto type_app = type->isa<TypeApp>()) {
         for (size_t i = 0, n = std::min(type_args.size(), type_app->type_args.size()); i < n; ++i)
             type_args[i]->bounds(bounds, type_app->type_args[i], dir);
@@ -411,11 +410,24 @@ bool TypeApp::is_sized(std::unordered_set<const Type*>& seen) const {
 
 // Complex Types -------------------------------------------------------------------
 
-std::optional<size_t> ComplexType::find_member(const std::string_view& name) const {
-    for (size_t i = 0, n = member_count(); i < n; ++i) {
-        if (member_name(i) == name)
-            return std::make_optional(i);
+std::optional<size_t> ComplexType::find_member(Name name) const {
+    auto n = member_count();
+    if (n < min_indexed_members) {
+        for (size_t i = 0; i < n; ++i) {
+            if (member_name(i) == name)
+                return std::make_optional(i);
+        }
+        return std::nullopt;
     }
+    if (!member_index_) {
+        // If several members have the same name, the first one is found
+        member_index_ = std::make_unique<std::unordered_map<Name, size_t>>();
+        member_index_->reserve(n);
+        for (size_t i = 0; i < n; ++i)
+            member_index_->emplace(member_name(i), i);
+    }
+    if (auto it = member_index_->find(name); it != member_index_->end())
+        return std::make_optional(it->second);
     return std::nullopt;
 }
 
@@ -425,7 +437,7 @@ const ast::TypeParamList* StructType::type_params() const {
         : decl.as<ast::OptionDecl>()->parent->type_params.get();
 }
 
-std::string_view StructType::member_name(size_t i) const {
+Name StructType::member_name(size_t i) const {
     return decl.fields[i]->id.name;
 }
 
@@ -437,7 +449,7 @@ size_t StructType::member_count() const {
     return decl.fields.size();
 }
 
-std::string_view EnumType::member_name(size_t i) const {
+Name EnumType::member_name(size_t i) const {
     return decl.options[i]->id.name;
 }
 
@@ -449,7 +461,7 @@ size_t EnumType::member_count() const {
     return decl.options.size();
 }
 
-std::string_view ModType::member_name(size_t i) const {
+Name ModType::member_name(size_t i) const {
     return members()[i].name;
 }
 
@@ -479,12 +491,26 @@ const ModType::Members& ModType::members() const {
 const Type* TypeApp::member_type(size_t i) const {
     if (auto enum_t = applied->isa<EnumType>(); enum_t && enum_t->decl.options[i]->struct_type)
         return type_table.type_app(enum_t->decl.options[i]->struct_type->as<StructType>(), type_args);
-    return applied->as<ComplexType>()->member_type(i)->replace(replace_map());
+    return type_table.replace(applied->as<ComplexType>()->member_type(i), replace_map());
 }
 
 // Misc. ---------------------------------------------------------------------------
 
 bool Type::subtype(const Type* other) const {
+    if (this == other)
+        return true;
+    auto key = std::make_pair(this, other);
+    if (auto it = type_table.subtype_cache_.find(key); it != type_table.subtype_cache_.end()) {
+        type_table.stats_.subtype.hits++;
+        return it->second;
+    }
+    type_table.stats_.subtype.misses++;
+    auto result = compute_subtype(other);
+    type_table.subtype_cache_.emplace(key, result);
+    return result;
+}
+
+bool Type::compute_subtype(const Type* other) const {
     if (this == other || isa<BottomType>() || other->isa<TopType>())
         return true;
 
@@ -539,11 +565,17 @@ bool Type::subtype(const Type* other) const {
 }
 
 const Type* Type::join(const Type* other) const {
-    if (subtype(other))
-        return other;
-    if (other->subtype(this))
+    if (this == other)
         return this;
-    return type_table.top_type();
+    auto key = std::make_pair(this, other);
+    if (auto it = type_table.join_cache_.find(key); it != type_table.join_cache_.end()) {
+        type_table.stats_.join.hits++;
+        return it->second;
+    }
+    type_table.stats_.join.misses++;
+    auto result = subtype(other) ? other : other->subtype(this) ? this : type_table.top_type();
+    type_table.join_cache_.emplace(key, result);
+    return result;
 }
 
 bool AddrType::is_compatible_with(const AddrType* other) const {
@@ -551,13 +583,7 @@ bool AddrType::is_compatible_with(const AddrType* other) const {
 }
 
 const Type* ForallType::instantiate(const ArrayRef<const Type*>& args) const {
-    std::unordered_map<const TypeVar*, const Type*> map;
-    assert(decl.type_params && decl.type_params->params.size() == args.size());
-    for (size_t i = 0, n = args.size(); i < n; ++i) {
-        assert(decl.type_params->params[i]->type);
-        map.emplace(decl.type_params->params[i]->type->as<TypeVar>(), args[i]); 
-    }
-    return body->replace(map);
+    return type_table.instantiate(this, args);
 }
 
 bool StructType::is_tuple_like() const {
@@ -571,11 +597,11 @@ bool EnumType::is_trivial() const {
         [] (auto& o) { return is_unit_type(o->type); });
 }
 
-std::unordered_map<const TypeVar*, const Type*> TypeApp::replace_map(
+ReplaceMap TypeApp::replace_map(
     const ast::TypeParamList& type_params,
     const ArrayRef<const Type*>& type_args)
 {
-    std::unordered_map<const TypeVar*, const Type*> map;
+    ReplaceMap map;
     assert(type_params.params.size() == type_args.size());
     for (size_t i = 0, n = type_args.size(); i < n; ++i) {
         assert(type_params.params[i]->type);
@@ -637,10 +663,9 @@ bool is_unit_type(const Type* type) {
 
 // Type table ----------------------------------------------------------------------
 
-TypeTable::~TypeTable() {
-    for (auto t : types_)
-        delete t;
-}
+TypeTable::TypeTable()
+    : types_(min_capacity, nullptr)
+{}
 
 const PrimType* TypeTable::prim_type(ast::PrimType::Tag tag) {
     return insert<PrimType>(tag);
@@ -730,18 +755,113 @@ const Type* TypeTable::type_app(const UserType* applied, const ArrayRef<const Ty
     if (auto type_alias = applied->isa<TypeAlias>()) {
         assert(type_alias->type_params() && type_alias->decl.aliased_type->type);
         auto map = TypeApp::replace_map(*type_alias->type_params(), type_args);
-        return type_alias->decl.aliased_type->type->replace(map);
+        return replace(type_alias->decl.aliased_type->type, map);
     }
     return insert<TypeApp>(applied, std::move(type_args));
 }
 
+const Type* TypeTable::replace(const Type* type, const ReplaceMap& map) {
+    if (map.empty())
+        return type;
+
+    // Only the type variables that appear in the type are part of the substitution,
+    // which is identified by those variables, in an arbitrary but fixed order, each
+    // followed by its replacement.
+    auto& vars = type->variance();
+    SmallArray<std::pair<const TypeVar*, const Type*>> pairs(vars.size());
+    size_t n = 0;
+    for (auto& [var, _] : vars) {
+        if (auto it = map.find(var); it != map.end())
+            pairs[n++] = *it;
+    }
+    if (n == 0)
+        return type;
+    std::sort(pairs.begin(), pairs.begin() + n);
+    SmallArray<const Type*> types(n * 2);
+    for (size_t i = 0; i < n; ++i) {
+        types[i * 2 + 0] = pairs[i].first;
+        types[i * 2 + 1] = pairs[i].second;
+    }
+
+    SubstKey key(type, types);
+    if (auto it = replace_cache_.find(key); it != replace_cache_.end())
+        return it->second;
+    auto result = type->replace(map);
+    key.types = copy(key.types);
+    replace_cache_.emplace(key, result);
+    return result;
+}
+
+const Type* TypeTable::instantiate(const ForallType* forall_type, const ArrayRef<const Type*>& args) {
+    auto& decl = forall_type->decl;
+    assert(decl.type_params && decl.type_params->params.size() == args.size());
+
+    // The body is part of the key, as it is only set once the function has been type-checked
+    SmallArray<const Type*> types(args.size() + 1);
+    types[0] = forall_type->body;
+    std::copy(args.begin(), args.end(), types.begin() + 1);
+    SubstKey key(forall_type, types);
+    if (auto it = instantiate_cache_.find(key); it != instantiate_cache_.end())
+        return it->second;
+
+    ReplaceMap map;
+    for (size_t i = 0, n = args.size(); i < n; ++i) {
+        assert(decl.type_params->params[i]->type);
+        map.emplace(decl.type_params->params[i]->type->as<TypeVar>(), args[i]);
+    }
+    auto result = forall_type->body->replace(map);
+    key.types = copy(key.types);
+    instantiate_cache_.emplace(key, result);
+    return result;
+}
+
+ArrayRef<const Type*> TypeTable::copy(const ArrayRef<const Type*>& types) {
+    if (types.empty())
+        return ArrayRef<const Type*>();
+    arena_vector<const Type*> storage(arena_, types.begin(), types.end());
+    return ArrayRef<const Type*>(storage.data(), storage.size());
+}
+
+void TypeTable::rehash(size_t capacity) {
+    std::vector<const Type*> types(capacity, nullptr);
+    for (auto type : types_) {
+        if (!type)
+            continue;
+        auto i = type->hash() & (capacity - 1);
+        while (types[i])
+            i = (i + 1) & (capacity - 1);
+        types[i] = type;
+    }
+    types_.swap(types);
+}
+
 template <typename T, typename... Args>
 const T* TypeTable::insert(Args&&... args) {
-    T t(*this, std::forward<Args>(args)...);
-    if (auto it = types_.find(&t); it != types_.end())
-        return (*it)->template as<T>();
-    auto [it, _] = types_.emplace(new T(std::move(t)));
-    return (*it)->template as<T>();
+    // The key refers to the arguments given by the caller,
+    // which are only copied when a new type is created.
+    T key(*this, std::forward<Args>(args)...);
+    key.hash_ = key.compute_hash();
+
+    // Keep the load factor below 3/4
+    if ((type_count_ + 1) * 4 > types_.size() * 3)
+        rehash(types_.size() * 2);
+
+    auto mask = types_.size() - 1;
+    auto i = key.hash_ & mask;
+    for (; types_[i]; i = (i + 1) & mask) {
+        auto type = types_[i];
+        if (type->hash_ == key.hash_ && type->kind == key.kind && key.equals(type))
+            return static_cast<const T*>(type);
+    }
+
+    if constexpr (std::is_same_v<T, TupleType>)
+        key.args = copy(key.args);
+    else if constexpr (std::is_same_v<T, TypeApp>)
+        key.type_args = copy(key.type_args);
+    auto type = arena_.make_ptr<T>(std::move(key)).get();
+    types_[i] = type;
+    type_count_++;
+    return type;
 }
 
 } // namespace artic